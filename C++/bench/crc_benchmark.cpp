@@ -0,0 +1,85 @@
+#include "modbus_crc.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+using CrcFunction = uint16_t (*)(const uint8_t*, size_t);
+
+struct Variant {
+    const char* name;
+    CrcFunction function;
+};
+
+volatile uint16_t sink;
+
+double measureNsPerFrame(CrcFunction function, const std::vector<uint8_t>& data, size_t frameSize) {
+    size_t frames = data.size() / frameSize;
+    size_t iterations = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::steady_clock::duration::zero();
+
+    while (elapsed < std::chrono::milliseconds(200)) {
+        for (size_t f = 0; f < frames; ++f) {
+            sink = function(data.data() + f * frameSize, frameSize);
+        }
+        iterations += frames;
+        elapsed = std::chrono::steady_clock::now() - start;
+    }
+
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+}
+
+} // namespace
+
+int main() {
+    const Variant variants[] = {
+        {"bitwise", modbus::crc::bitwise},
+        {"table", modbus::crc::table},
+        {"slice4", modbus::crc::slice4},
+        {"slice8", modbus::crc::slice8},
+        {"crc16", modbus::crc16},
+    };
+    const size_t frameSizes[] = {6, 8, 256, 4096};
+
+    std::vector<uint8_t> data(1 << 20);
+    std::mt19937 rng(42);
+    for (auto& byte : data) {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    for (size_t frameSize : frameSizes) {
+        uint16_t expected = modbus::crc::bitwise(data.data(), frameSize);
+        for (const auto& variant : variants) {
+            if (variant.function(data.data(), frameSize) != expected) {
+                std::cerr << "CRC结果不一致: " << variant.name << ", 帧长 " << frameSize << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    std::cout << std::left << std::setw(10) << "帧长" ;
+    for (const auto& variant : variants) {
+        std::cout << std::right << std::setw(14) << variant.name;
+    }
+    std::cout << std::endl;
+
+    for (size_t frameSize : frameSizes) {
+        std::cout << std::left << std::setw(10) << frameSize;
+        for (const auto& variant : variants) {
+            double ns = measureNsPerFrame(variant.function, data, frameSize);
+            double mbps = static_cast<double>(frameSize) / ns * 1000.0;
+            std::cout << std::right << std::setw(8) << std::fixed << std::setprecision(1) << ns << "ns/"
+                      << std::setw(4) << std::setprecision(0) << mbps;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "(每帧耗时ns / 吞吐量MB/s)" << std::endl;
+
+    return EXIT_SUCCESS;
+}
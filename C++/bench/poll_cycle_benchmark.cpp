@@ -0,0 +1,343 @@
+#include "config.h"
+#include "data_storage.h"
+#include "modbus_crc.h"
+#include "sensor_reader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace {
+
+std::atomic<unsigned long long> allocationCount(0);
+
+struct Options {
+    int ports = 2;
+    int sensorsPerPort = 8;
+    int cycles = 200;
+    int warmup = 10;
+    int baudrate = 115200;
+    long long gapUs = 0;
+    std::string mode;
+    std::string influxdbUrl;
+};
+
+struct Backend {
+    std::string name;
+    StorageType type;
+};
+
+struct Result {
+    double cyclesPerSecond;
+    double p50Ms;
+    double p99Ms;
+    double allocationsPerCycle;
+    size_t errors;
+};
+
+class PtySlaves {
+public:
+    ~PtySlaves() {
+        stop();
+        for (int fd : masters_) close(fd);
+        for (int fd : slaves_) close(fd);
+    }
+
+    bool open(int count) {
+        for (int i = 0; i < count; ++i) {
+            int master = -1;
+            int slave = -1;
+            char name[256];
+            if (openpty(&master, &slave, name, nullptr, nullptr) != 0) {
+                std::cerr << "openpty失败" << std::endl;
+                return false;
+            }
+            struct termios tty;
+            tcgetattr(master, &tty);
+            cfmakeraw(&tty);
+            tcsetattr(master, TCSANOW, &tty);
+            fcntl(master, F_SETFL, fcntl(master, F_GETFL, 0) | O_NONBLOCK);
+            masters_.push_back(master);
+            slaves_.push_back(slave);
+            names_.push_back(name);
+        }
+        running_ = true;
+        thread_ = std::thread([this]() { serve(); });
+        return true;
+    }
+
+    void stop() {
+        running_ = false;
+        if (thread_.joinable()) thread_.join();
+    }
+
+    const std::vector<std::string>& names() const { return names_; }
+
+private:
+    void serve() {
+        std::vector<pollfd> fds(masters_.size());
+        std::vector<std::vector<uint8_t>> pending(masters_.size());
+        uint8_t rx[512];
+        uint8_t tx[260];
+
+        while (running_) {
+            for (size_t i = 0; i < masters_.size(); ++i) {
+                fds[i] = {masters_[i], POLLIN, 0};
+            }
+            if (poll(fds.data(), fds.size(), 50) <= 0) continue;
+
+            for (size_t i = 0; i < masters_.size(); ++i) {
+                if (!(fds[i].revents & POLLIN)) continue;
+                ssize_t n = read(masters_[i], rx, sizeof(rx));
+                if (n <= 0) continue;
+
+                auto& buffer = pending[i];
+                buffer.insert(buffer.end(), rx, rx + n);
+                while (buffer.size() >= 8) {
+                    if (!modbus::checkCrc(buffer.data(), 8)) {
+                        buffer.erase(buffer.begin());
+                        continue;
+                    }
+                    uint8_t slaveId = buffer[0];
+                    uint16_t start = static_cast<uint16_t>((buffer[2] << 8) | buffer[3]);
+                    uint16_t count = static_cast<uint16_t>((buffer[4] << 8) | buffer[5]);
+                    tx[0] = slaveId;
+                    tx[1] = buffer[1];
+                    tx[2] = static_cast<uint8_t>(count * 2);
+                    for (uint16_t r = 0; r < count; ++r) {
+                        uint16_t value = static_cast<uint16_t>(200 + slaveId * 10 + start + r);
+                        tx[3 + r * 2] = (value >> 8) & 0xFF;
+                        tx[4 + r * 2] = value & 0xFF;
+                    }
+                    size_t length = 3 + count * 2;
+                    uint16_t crc = modbus::crc16(tx, length);
+                    tx[length] = crc & 0xFF;
+                    tx[length + 1] = (crc >> 8) & 0xFF;
+                    if (write(masters_[i], tx, length + 2) < 0) break;
+                    buffer.erase(buffer.begin(), buffer.begin() + 8);
+                }
+            }
+        }
+    }
+
+    std::vector<int> masters_;
+    std::vector<int> slaves_;
+    std::vector<std::string> names_;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        std::string value = argv[i + 1];
+        if (arg == "--ports") options.ports = std::atoi(value.c_str());
+        else if (arg == "--sensors") options.sensorsPerPort = std::atoi(value.c_str());
+        else if (arg == "--cycles") options.cycles = std::atoi(value.c_str());
+        else if (arg == "--baud") options.baudrate = std::atoi(value.c_str());
+        else if (arg == "--gap-us") options.gapUs = std::atoll(value.c_str());
+        else if (arg == "--mode") options.mode = value;
+        else if (arg == "--influxdb-url") options.influxdbUrl = value;
+        else return false;
+    }
+    return (argc % 2) == 1 && options.ports > 0 && options.sensorsPerPort > 0 &&
+           options.sensorsPerPort <= 247 && options.cycles > 0;
+}
+
+double percentile(std::vector<double> samples, double fraction) {
+    std::sort(samples.begin(), samples.end());
+    size_t index = static_cast<size_t>(fraction * (samples.size() - 1) + 0.5);
+    return samples[index];
+}
+
+Result runCycles(MultiPortReader& reader, const PollPlan& plan, DataStorage* storage, const Options& options) {
+    std::vector<size_t> sensors(plan.size());
+    std::iota(sensors.begin(), sensors.end(), 0);
+    std::vector<SensorData> results;
+    std::vector<SensorRecord> records;
+    for (int i = 0; i < options.warmup; ++i) {
+        reader.readSensors(plan, sensors, results);
+        convertToRecords(results, plan.names, records);
+        if (storage && !records.empty()) storage->saveBatch(records);
+    }
+
+    std::vector<double> latencies;
+    latencies.reserve(options.cycles);
+    size_t errors = 0;
+
+    unsigned long long allocationsBefore = allocationCount.load();
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < options.cycles; ++i) {
+        auto cycleStart = std::chrono::steady_clock::now();
+        reader.readSensors(plan, sensors, results);
+        convertToRecords(results, plan.names, records);
+        if (storage && !records.empty()) storage->saveBatch(records);
+        auto cycleEnd = std::chrono::steady_clock::now();
+
+        errors += results.size() - records.size();
+        latencies.push_back(std::chrono::duration<double, std::milli>(cycleEnd - cycleStart).count());
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    unsigned long long allocations = allocationCount.load() - allocationsBefore;
+
+    Result result;
+    result.cyclesPerSecond = options.cycles / std::chrono::duration<double>(elapsed).count();
+    result.p50Ms = percentile(latencies, 0.50);
+    result.p99Ms = percentile(latencies, 0.99);
+    result.allocationsPerCycle = static_cast<double>(allocations) / options.cycles;
+    result.errors = errors;
+    return result;
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "用法: " << argv[0]
+                  << " [--ports N] [--sensors N] [--cycles N] [--baud N] [--gap-us N]"
+                  << " [--mode sequential|parallel|reactor] [--influxdb-url URL]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    PtySlaves slaves;
+    if (!slaves.open(options.ports)) {
+        return EXIT_FAILURE;
+    }
+
+    MultiPortReader reader;
+    std::vector<SensorConfig> sensors;
+    for (int p = 0; p < options.ports; ++p) {
+        std::string portName = "bench" + std::to_string(p);
+        reader.addPort(portName, slaves.names()[p], options.baudrate, 8, 1, 'N', 200);
+        for (int s = 0; s < options.sensorsPerPort; ++s) {
+            uint8_t slaveId = static_cast<uint8_t>(s + 1);
+            if (options.gapUs > 0) {
+                reader.setSlaveGap(portName, slaveId, std::chrono::microseconds(options.gapUs));
+            }
+            SensorConfig sensor{};
+            sensor.name = portName + "_s" + std::to_string(slaveId);
+            sensor.slave_id = slaveId;
+            sensor.temp_reg = 0;
+            sensor.humi_reg = 1;
+            sensor.temp_scale = 1.0;
+            sensor.humi_scale = 1.0;
+            sensor.port_name = portName;
+            sensor.function_code = 0x03;
+            sensor.temp_format = defaultPointFormat();
+            sensor.humi_format = defaultPointFormat();
+            sensors.push_back(sensor);
+        }
+    }
+
+    PollPlan plan = reader.compilePlan(sensors);
+
+    if (!reader.connectAll()) {
+        std::cerr << "无法连接到模拟串口" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::pair<std::string, PollMode>> modes = {
+        {"sequential", PollMode::Sequential},
+        {"parallel", PollMode::Parallel},
+        {"reactor", PollMode::Reactor},
+    };
+    if (!options.mode.empty()) {
+        modes.erase(std::remove_if(modes.begin(), modes.end(),
+                                   [&](const auto& mode) { return mode.first != options.mode; }),
+                    modes.end());
+    }
+
+    std::vector<Backend> backends = {
+        {"none", StorageType::None},
+        {"csv", StorageType::CSV},
+        {"sqlite", StorageType::SQLite},
+    };
+#ifdef ENABLE_INFLUXDB
+    if (!options.influxdbUrl.empty()) {
+        backends.push_back({"influxdb", StorageType::InfluxDB});
+    }
+#endif
+
+    std::string csvPath = "poll_cycle_benchmark.csv";
+    std::string sqlitePath = "poll_cycle_benchmark.db";
+
+    std::cout << options.ports << " 个串口 x " << options.sensorsPerPort << " 个传感器, "
+              << options.cycles << " 个周期, 波特率 " << options.baudrate << std::endl;
+    std::cout << std::left << std::setw(12) << "mode" << std::setw(10) << "storage"
+              << std::right << std::setw(12) << "cycles/s" << std::setw(12) << "p50 ms"
+              << std::setw(12) << "p99 ms" << std::setw(14) << "allocs/cycle"
+              << std::setw(10) << "errors" << std::endl;
+
+    for (const auto& mode : modes) {
+        reader.setPollMode(mode.second);
+        for (const auto& backend : backends) {
+            std::remove(csvPath.c_str());
+            std::remove(sqlitePath.c_str());
+
+            StorageConfig storageConfig{};
+            storageConfig.type = backend.type;
+            storageConfig.csv_path = csvPath;
+            storageConfig.sqlite_path = sqlitePath;
+            storageConfig.influxdb_url = options.influxdbUrl;
+
+            std::unique_ptr<DataStorage> storage;
+            if (backend.type != StorageType::None) {
+                storage = StorageFactory::create(backend.type, storageConfig);
+                if (!storage) {
+                    std::cerr << "无法创建存储: " << backend.name << std::endl;
+                    continue;
+                }
+            }
+
+            Result result = runCycles(reader, plan, storage.get(), options);
+            if (storage) storage->close();
+
+            std::cout << std::left << std::setw(12) << mode.first << std::setw(10) << backend.name
+                      << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(12) << result.cyclesPerSecond
+                      << std::setprecision(3) << std::setw(12) << result.p50Ms
+                      << std::setw(12) << result.p99Ms
+                      << std::setprecision(1) << std::setw(14) << result.allocationsPerCycle
+                      << std::setw(10) << result.errors << std::endl;
+        }
+    }
+
+    reader.disconnectAll();
+    std::remove(csvPath.c_str());
+    std::remove(sqlitePath.c_str());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,59 @@
+#ifndef CIRCUIT_BREAKER_H
+#define CIRCUIT_BREAKER_H
+
+#include <algorithm>
+#include <chrono>
+
+struct BreakerOptions {
+    int failure_threshold;
+    std::chrono::milliseconds retry_min;
+    std::chrono::milliseconds retry_max;
+};
+
+class CircuitBreaker {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    CircuitBreaker() : failures_(0), open_(false), retryDelay_(0) {}
+
+    static BreakerOptions defaultOptions() {
+        return {3, std::chrono::seconds(10), std::chrono::seconds(300)};
+    }
+
+    bool isOpen() const {
+        return open_;
+    }
+
+    bool allow(Clock::time_point now) {
+        if (!open_) return true;
+        if (now < nextProbe_) return false;
+        nextProbe_ = now + retryDelay_;
+        return true;
+    }
+
+    void onSuccess() {
+        failures_ = 0;
+        open_ = false;
+    }
+
+    void onFailure(Clock::time_point now, const BreakerOptions& options) {
+        if (open_) {
+            retryDelay_ = std::min(retryDelay_ * 2, options.retry_max);
+            nextProbe_ = now + retryDelay_;
+            return;
+        }
+        if (options.failure_threshold > 0 && ++failures_ >= options.failure_threshold) {
+            open_ = true;
+            retryDelay_ = options.retry_min;
+            nextProbe_ = now + retryDelay_;
+        }
+    }
+
+private:
+    int failures_;
+    bool open_;
+    std::chrono::milliseconds retryDelay_;
+    Clock::time_point nextProbe_;
+};
+
+#endif
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <chrono>
 #include <functional>
+#include "point_decoder.h"
 
 #ifndef CONFIG_H
 #define CONFIG_H
@@ -15,21 +16,55 @@ struct SensorConfig {
     double temp_scale;
     double humi_scale;
     std::string port_name;
+    uint8_t function_code;
+    double inter_frame_gap_ms;
+    PointFormat temp_format;
+    PointFormat humi_format;
+    double poll_interval;
+};
+
+enum class TransportType {
+    RTU,
+    TCP
 };
 
 struct PortConfig {
     std::string name;
+    TransportType transport;
     std::string port;
     int baudrate;
     int data_bits;
     int stop_bits;
     char parity;
     double timeout;
+    double min_timeout;
+    double max_timeout;
+    bool rs485;
+    bool low_latency;
+    int rs485_delay_before_send;
+    int rs485_delay_after_send;
+    std::string host;
+    int tcp_port;
+    int max_in_flight;
+};
+
+enum class PollMode {
+    Sequential,
+    Parallel,
+    Reactor
 };
 
 struct ModbusConfig {
     std::vector<PortConfig> ports;
     int read_interval;
+    PollMode poll_mode;
+    int coalesce_max_gap;
+    int coalesce_max_registers;
+    int offline_failures;
+    double offline_retry;
+    double offline_retry_max;
+    int realtime_priority;
+    std::vector<int> cpu_affinity;
     std::vector<SensorConfig> sensors;
 };
 
@@ -40,14 +75,46 @@ enum class StorageType {
     CSV
 };
 
+enum class SQLiteSchema {
+    Legacy,
+    Compact
+};
+
+enum class PartitionPeriod {
+    None,
+    Day,
+    Week
+};
+
+enum class Backpressure {
+    Block,
+    DropOldest,
+    Spill
+};
+
 struct StorageConfig {
     StorageType type;
     std::string sqlite_path;
+    SQLiteSchema sqlite_schema;
+    PartitionPeriod sqlite_partition;
+    int sqlite_retention_days;
+    bool sqlite_rollups;
+    std::string sqlite_journal_mode;
+    std::string sqlite_synchronous;
+    int sqlite_page_size;
+    int sqlite_cache_kb;
+    int sqlite_mmap_mb;
+    int sqlite_checkpoint_pages;
     std::string influxdb_url;
     std::string influxdb_token;
     std::string influxdb_org;
     std::string influxdb_bucket;
     std::string csv_path;
+    size_t queue_capacity;
+    size_t batch_size;
+    double commit_interval;
+    Backpressure backpressure;
+    std::string spill_path;
 };
 
 struct AppConfig {
@@ -60,9 +127,12 @@ public:
     static AppConfig load(const std::string& filename);
     static AppConfig loadDefault();
     static bool exists(const std::string& filename);
-    void print() const;
-    std::chrono::milliseconds getTimeout() const;
-    std::chrono::seconds getReadInterval() const;
+    static void print(const AppConfig& config);
+    static std::chrono::milliseconds getTimeout(const PortConfig& port);
+    static std::chrono::microseconds getMinTimeout(const PortConfig& port);
+    static std::chrono::microseconds getMaxTimeout(const PortConfig& port);
+    static std::chrono::seconds getReadInterval(const AppConfig& config);
+    static std::chrono::microseconds getPollInterval(const SensorConfig& sensor);
 
 private:
     AppConfig config_;
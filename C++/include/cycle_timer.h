@@ -0,0 +1,46 @@
+#ifndef CYCLE_TIMER_H
+#define CYCLE_TIMER_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+struct RealtimeOptions {
+    int priority;
+    std::vector<int> cpus;
+};
+
+namespace cycle {
+
+using Clock = std::chrono::steady_clock;
+
+bool sleepUntil(Clock::time_point deadline);
+bool applyRealtime(const RealtimeOptions& options);
+bool lockMemory();
+
+} // namespace cycle
+
+class CycleStats {
+public:
+    using Duration = std::chrono::microseconds;
+
+    CycleStats();
+
+    void recordStart(cycle::Clock::time_point deadline, cycle::Clock::time_point actual);
+    void recordEnd(cycle::Clock::time_point end, cycle::Clock::time_point nextDeadline);
+
+    uint64_t cycles() const;
+    uint64_t overruns() const;
+    Duration meanJitter() const;
+    Duration maxJitter() const;
+    Duration lastJitter() const;
+
+private:
+    uint64_t cycles_;
+    uint64_t overruns_;
+    Duration totalJitter_;
+    Duration maxJitter_;
+    Duration lastJitter_;
+};
+
+#endif
@@ -1,13 +1,18 @@
 #ifndef DATA_STORAGE_H
 #define DATA_STORAGE_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <chrono>
 #include <memory>
 
+#include "config.h"
+#include "sensor_reader.h"
+
 struct SensorRecord {
     std::string sensor_name;
+    uint32_t sensor_id;
     int slave_id;
     double temperature;
     double humidity;
@@ -20,12 +25,19 @@ public:
     virtual bool save(const SensorRecord& record) = 0;
     virtual bool saveBatch(const std::vector<SensorRecord>& records) = 0;
     virtual void close() = 0;
+    virtual uint64_t duplicates() const { return 0; }
 };
 
 class StorageFactory {
 public:
-    static std::unique_ptr<DataStorage> create(StorageType type, const StorageConfig& config);
+    static std::unique_ptr<DataStorage> create(StorageType type, const StorageConfig& config,
+                                               const std::vector<SensorConfig>& sensors = {});
     static std::string storageTypeToString(StorageType type);
 };
 
+std::vector<SensorRecord> convertToRecords(const std::vector<SensorData>& data,
+                                           const std::vector<std::string>& names);
+void convertToRecords(const std::vector<SensorData>& data, const std::vector<std::string>& names,
+                      std::vector<SensorRecord>& records);
+
 #endif
@@ -0,0 +1,117 @@
+#ifndef MODBUS_CRC_H
+#define MODBUS_CRC_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace modbus {
+namespace crc {
+
+constexpr uint16_t kPolynomial = 0xA001;
+constexpr uint16_t kInitial = 0xFFFF;
+
+using Table = std::array<uint16_t, 256>;
+using SliceTables = std::array<Table, 8>;
+
+constexpr Table makeTable() {
+    Table table{};
+    for (uint16_t i = 0; i < 256; ++i) {
+        uint16_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x0001) ? static_cast<uint16_t>((crc >> 1) ^ kPolynomial)
+                                 : static_cast<uint16_t>(crc >> 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr SliceTables makeSliceTables() {
+    SliceTables tables{};
+    tables[0] = makeTable();
+    for (size_t k = 1; k < tables.size(); ++k) {
+        for (size_t i = 0; i < 256; ++i) {
+            uint16_t prev = tables[k - 1][i];
+            tables[k][i] = static_cast<uint16_t>((prev >> 8) ^ tables[0][prev & 0xFF]);
+        }
+    }
+    return tables;
+}
+
+inline constexpr SliceTables kTables = makeSliceTables();
+
+constexpr uint16_t bitwise(const uint8_t* data, size_t length) {
+    uint16_t crc = kInitial;
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x0001) ? static_cast<uint16_t>((crc >> 1) ^ kPolynomial)
+                                 : static_cast<uint16_t>(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+constexpr uint16_t table(const uint8_t* data, size_t length) {
+    uint16_t crc = kInitial;
+    for (size_t i = 0; i < length; ++i) {
+        crc = static_cast<uint16_t>((crc >> 8) ^ kTables[0][(crc ^ data[i]) & 0xFF]);
+    }
+    return crc;
+}
+
+constexpr uint16_t slice4(const uint8_t* data, size_t length) {
+    uint16_t crc = kInitial;
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4) {
+        uint16_t low = static_cast<uint16_t>(crc ^ (data[i] | (data[i + 1] << 8)));
+        crc = static_cast<uint16_t>(kTables[3][low & 0xFF] ^ kTables[2][low >> 8] ^
+                                    kTables[1][data[i + 2]] ^ kTables[0][data[i + 3]]);
+    }
+    for (; i < length; ++i) {
+        crc = static_cast<uint16_t>((crc >> 8) ^ kTables[0][(crc ^ data[i]) & 0xFF]);
+    }
+    return crc;
+}
+
+constexpr uint16_t slice8(const uint8_t* data, size_t length) {
+    uint16_t crc = kInitial;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint16_t low = static_cast<uint16_t>(crc ^ (data[i] | (data[i + 1] << 8)));
+        crc = static_cast<uint16_t>(kTables[7][low & 0xFF] ^ kTables[6][low >> 8] ^
+                                    kTables[5][data[i + 2]] ^ kTables[4][data[i + 3]] ^
+                                    kTables[3][data[i + 4]] ^ kTables[2][data[i + 5]] ^
+                                    kTables[1][data[i + 6]] ^ kTables[0][data[i + 7]]);
+    }
+    for (; i < length; ++i) {
+        crc = static_cast<uint16_t>((crc >> 8) ^ kTables[0][(crc ^ data[i]) & 0xFF]);
+    }
+    return crc;
+}
+
+} // namespace crc
+
+constexpr uint16_t crc16(const uint8_t* data, size_t length) {
+    return length >= 8 ? crc::slice8(data, length) : crc::slice4(data, length);
+}
+
+constexpr bool checkCrc(const uint8_t* frame, size_t length) {
+    return length >= 3 &&
+           crc16(frame, length - 2) == static_cast<uint16_t>(frame[length - 2] | (frame[length - 1] << 8));
+}
+
+namespace crc {
+
+constexpr uint8_t kCheckInput[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+static_assert(bitwise(kCheckInput, sizeof(kCheckInput)) == 0x4B37, "CRC-16/MODBUS check value");
+static_assert(table(kCheckInput, sizeof(kCheckInput)) == 0x4B37, "CRC-16/MODBUS check value");
+static_assert(slice4(kCheckInput, sizeof(kCheckInput)) == 0x4B37, "CRC-16/MODBUS check value");
+static_assert(slice8(kCheckInput, sizeof(kCheckInput)) == 0x4B37, "CRC-16/MODBUS check value");
+
+} // namespace crc
+
+} // namespace modbus
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef MODBUS_REACTOR_H
+#define MODBUS_REACTOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <functional>
+#include <memory>
+
+enum class TransactionStatus {
+    Completed,
+    Timeout,
+    Rejected,
+    IoError
+};
+
+class ModbusReactor {
+public:
+    using Completion = std::function<void(TransactionStatus status, const uint8_t* frame, size_t length,
+                                          std::chrono::microseconds elapsed)>;
+    using Task = std::function<void()>;
+
+    ModbusReactor();
+    ~ModbusReactor();
+
+    bool isValid() const;
+    int nativeHandle() const;
+    int addChannel(int fd);
+    void removeChannel(int channel);
+    void submit(int channel, const uint8_t* request, size_t length,
+                std::chrono::microseconds gap, std::chrono::microseconds timeout, Completion done);
+    void post(Task task);
+    size_t pending() const;
+    void run();
+    void runOnce(int timeoutMs);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+#endif
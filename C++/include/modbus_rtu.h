@@ -0,0 +1,27 @@
+#ifndef MODBUS_RTU_H
+#define MODBUS_RTU_H
+
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+
+#include "modbus_crc.h"
+
+namespace modbus {
+
+constexpr size_t kReadRequestLength = 8;
+constexpr size_t kMinResponseLength = 5;
+constexpr size_t kMaxFrameLength = 256;
+constexpr size_t kRejectFrame = 0;
+
+std::chrono::microseconds interFrameGap(int baudrate, int dataBits, int stopBits, char parity);
+std::chrono::microseconds transmissionTime(size_t bytes, int baudrate, int dataBits, int stopBits, char parity);
+
+size_t responseFrameLength(const uint8_t* frame, size_t available, uint8_t slaveId);
+
+void encodeReadRequest(uint8_t slaveId, uint8_t funcCode, uint16_t regAddr,
+                       uint16_t regCount, uint8_t* out);
+
+} // namespace modbus
+
+#endif
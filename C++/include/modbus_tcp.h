@@ -0,0 +1,52 @@
+#ifndef MODBUS_TCP_H
+#define MODBUS_TCP_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+#include "read_error.h"
+
+struct TcpReadRequest {
+    uint8_t unit_id;
+    uint8_t function_code;
+    uint16_t start;
+    uint16_t count;
+};
+
+class ModbusTcpClient {
+public:
+    using Completion = std::function<void(size_t index, const uint8_t* adu, size_t length,
+                                          ReadError error)>;
+
+    ModbusTcpClient(const std::string& host, int port, int timeoutMs, int maxInFlight);
+    ~ModbusTcpClient();
+
+    bool connect();
+    void disconnect();
+    bool isConnected() const;
+    void execute(const std::vector<TcpReadRequest>& requests, const Completion& done);
+
+private:
+    struct Pending {
+        uint16_t transaction_id;
+        size_t index;
+        long long deadline_ms;
+    };
+
+    bool sendRequest(const TcpReadRequest& request, uint16_t transactionId);
+    bool receive(int timeoutMs);
+
+    std::string host_;
+    int port_;
+    int timeoutMs_;
+    int maxInFlight_;
+    long long socket_;
+    uint16_t nextTransactionId_;
+    std::vector<uint8_t> rxBuffer_;
+    std::vector<Pending> pending_;
+};
+
+#endif
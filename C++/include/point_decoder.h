@@ -0,0 +1,178 @@
+#ifndef POINT_DECODER_H
+#define POINT_DECODER_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+enum class DataType : uint8_t {
+    UInt16,
+    Int16,
+    UInt32,
+    Int32,
+    Float32
+};
+
+enum class WordOrder : uint8_t {
+    ABCD,
+    CDAB,
+    BADC,
+    DCBA
+};
+
+using PointDecoder = double (*)(const uint16_t* registers);
+
+struct PointFormat {
+    DataType type;
+    WordOrder order;
+    uint8_t width;
+    PointDecoder decode;
+};
+
+namespace point {
+
+constexpr uint16_t swapBytes(uint16_t value) {
+    return static_cast<uint16_t>((value << 8) | (value >> 8));
+}
+
+template <WordOrder Order>
+inline uint16_t word16(const uint16_t* registers) {
+    if constexpr (Order == WordOrder::BADC || Order == WordOrder::DCBA) {
+        return swapBytes(registers[0]);
+    } else {
+        return registers[0];
+    }
+}
+
+template <WordOrder Order>
+inline uint32_t word32(const uint16_t* registers) {
+    if constexpr (Order == WordOrder::ABCD) {
+        return (static_cast<uint32_t>(registers[0]) << 16) | registers[1];
+    } else if constexpr (Order == WordOrder::CDAB) {
+        return (static_cast<uint32_t>(registers[1]) << 16) | registers[0];
+    } else if constexpr (Order == WordOrder::BADC) {
+        return (static_cast<uint32_t>(swapBytes(registers[0])) << 16) | swapBytes(registers[1]);
+    } else {
+        return (static_cast<uint32_t>(swapBytes(registers[1])) << 16) | swapBytes(registers[0]);
+    }
+}
+
+template <DataType Type, WordOrder Order>
+struct Decoder;
+
+template <WordOrder Order>
+struct Decoder<DataType::UInt16, Order> {
+    static constexpr uint8_t width = 1;
+    static double decode(const uint16_t* registers) {
+        return static_cast<double>(word16<Order>(registers));
+    }
+};
+
+template <WordOrder Order>
+struct Decoder<DataType::Int16, Order> {
+    static constexpr uint8_t width = 1;
+    static double decode(const uint16_t* registers) {
+        return static_cast<double>(static_cast<int16_t>(word16<Order>(registers)));
+    }
+};
+
+template <WordOrder Order>
+struct Decoder<DataType::UInt32, Order> {
+    static constexpr uint8_t width = 2;
+    static double decode(const uint16_t* registers) {
+        return static_cast<double>(word32<Order>(registers));
+    }
+};
+
+template <WordOrder Order>
+struct Decoder<DataType::Int32, Order> {
+    static constexpr uint8_t width = 2;
+    static double decode(const uint16_t* registers) {
+        return static_cast<double>(static_cast<int32_t>(word32<Order>(registers)));
+    }
+};
+
+template <WordOrder Order>
+struct Decoder<DataType::Float32, Order> {
+    static constexpr uint8_t width = 2;
+    static double decode(const uint16_t* registers) {
+        uint32_t bits = word32<Order>(registers);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return static_cast<double>(value);
+    }
+};
+
+template <DataType Type, WordOrder Order>
+constexpr PointFormat makeFormat() {
+    return {Type, Order, Decoder<Type, Order>::width, &Decoder<Type, Order>::decode};
+}
+
+template <DataType Type>
+struct FormatRow {
+    static constexpr PointFormat formats[4] = {
+        makeFormat<Type, WordOrder::ABCD>(),
+        makeFormat<Type, WordOrder::CDAB>(),
+        makeFormat<Type, WordOrder::BADC>(),
+        makeFormat<Type, WordOrder::DCBA>(),
+    };
+};
+
+} // namespace point
+
+inline PointFormat pointFormat(DataType type, WordOrder order) {
+    static constexpr const PointFormat* rows[] = {
+        point::FormatRow<DataType::UInt16>::formats,
+        point::FormatRow<DataType::Int16>::formats,
+        point::FormatRow<DataType::UInt32>::formats,
+        point::FormatRow<DataType::Int32>::formats,
+        point::FormatRow<DataType::Float32>::formats,
+    };
+    return rows[static_cast<size_t>(type)][static_cast<size_t>(order)];
+}
+
+inline PointFormat defaultPointFormat() {
+    return pointFormat(DataType::UInt16, WordOrder::ABCD);
+}
+
+inline bool parseDataType(const std::string& text, DataType& type) {
+    if (text == "uint16") type = DataType::UInt16;
+    else if (text == "int16") type = DataType::Int16;
+    else if (text == "uint32") type = DataType::UInt32;
+    else if (text == "int32") type = DataType::Int32;
+    else if (text == "float32" || text == "float") type = DataType::Float32;
+    else return false;
+    return true;
+}
+
+inline bool parseWordOrder(const std::string& text, WordOrder& order) {
+    if (text == "ABCD" || text == "abcd") order = WordOrder::ABCD;
+    else if (text == "CDAB" || text == "cdab") order = WordOrder::CDAB;
+    else if (text == "BADC" || text == "badc") order = WordOrder::BADC;
+    else if (text == "DCBA" || text == "dcba") order = WordOrder::DCBA;
+    else return false;
+    return true;
+}
+
+inline std::string dataTypeToString(DataType type) {
+    switch (type) {
+        case DataType::UInt16: return "uint16";
+        case DataType::Int16: return "int16";
+        case DataType::UInt32: return "uint32";
+        case DataType::Int32: return "int32";
+        case DataType::Float32: return "float32";
+    }
+    return "uint16";
+}
+
+inline std::string wordOrderToString(WordOrder order) {
+    switch (order) {
+        case WordOrder::ABCD: return "ABCD";
+        case WordOrder::CDAB: return "CDAB";
+        case WordOrder::BADC: return "BADC";
+        case WordOrder::DCBA: return "DCBA";
+    }
+    return "ABCD";
+}
+
+#endif
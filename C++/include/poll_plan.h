@@ -0,0 +1,48 @@
+#ifndef POLL_PLAN_H
+#define POLL_PLAN_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "point_decoder.h"
+#include "poll_planner.h"
+
+struct PollPlan {
+    static constexpr uint32_t kUnbound = 0xFFFFFFFF;
+
+    std::vector<std::string> names;
+    std::vector<uint8_t> slave_ids;
+    std::vector<uint32_t> ports;
+    std::vector<double> temp_scales;
+    std::vector<double> humi_scales;
+    std::vector<PointFormat> temp_formats;
+    std::vector<PointFormat> humi_formats;
+    std::vector<std::chrono::microseconds> periods;
+
+    std::vector<std::string> port_names;
+    std::vector<size_t> port_offsets;
+    std::vector<ReadBlock> blocks;
+
+    static PollPlan compile(const std::vector<SensorConfig>& sensors,
+                            const std::vector<std::string>& portNames,
+                            const PlannerOptions& options);
+
+    size_t size() const {
+        return names.size();
+    }
+
+    double value(size_t sensor, SensorField field, const uint16_t* registers) const {
+        return field == SensorField::Temperature
+            ? temp_formats[sensor].decode(registers) * temp_scales[sensor]
+            : humi_formats[sensor].decode(registers) * humi_scales[sensor];
+    }
+
+    void print(std::ostream& out) const;
+};
+
+#endif
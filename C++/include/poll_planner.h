@@ -0,0 +1,57 @@
+#ifndef POLL_PLANNER_H
+#define POLL_PLANNER_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "modbus_rtu.h"
+
+enum class SensorField : uint8_t {
+    Temperature,
+    Humidity
+};
+
+struct PlanEntry {
+    size_t sensor;
+    size_t port;
+    uint8_t slave_id;
+    uint8_t function_code;
+    uint16_t temp_reg;
+    uint16_t humi_reg;
+    uint8_t temp_width;
+    uint8_t humi_width;
+};
+
+struct BlockSlot {
+    size_t sensor;
+    SensorField field;
+    uint16_t offset;
+};
+
+struct ReadBlock {
+    size_t port;
+    uint8_t slave_id;
+    uint8_t function_code;
+    uint16_t start;
+    uint16_t count;
+    std::vector<BlockSlot> slots;
+    std::array<uint8_t, modbus::kReadRequestLength> request;
+};
+
+struct PlannerOptions {
+    uint16_t max_gap;
+    uint16_t max_registers;
+};
+
+class PollPlanner {
+public:
+    static constexpr uint16_t kMaxReadRegisters = 125;
+
+    static PlannerOptions defaultOptions();
+    static std::vector<ReadBlock> plan(const std::vector<PlanEntry>& entries,
+                                       const PlannerOptions& options);
+};
+
+#endif
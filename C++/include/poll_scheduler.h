@@ -0,0 +1,41 @@
+#ifndef POLL_SCHEDULER_H
+#define POLL_SCHEDULER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class PollScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Duration = std::chrono::microseconds;
+
+    PollScheduler(const std::vector<Duration>& periods, Clock::time_point start);
+
+    bool empty() const;
+    Clock::time_point nextDeadline() const;
+
+    std::vector<size_t> due(Clock::time_point now);
+    void due(Clock::time_point now, std::vector<size_t>& sensors);
+    Clock::time_point dueDeadline() const;
+
+    uint64_t missedDeadlines(size_t sensor) const;
+    uint64_t totalMissed() const;
+
+private:
+    struct Entry {
+        Clock::time_point deadline;
+        size_t sensor;
+    };
+
+    static bool later(const Entry& a, const Entry& b);
+
+    std::vector<Duration> periods_;
+    std::vector<Entry> heap_;
+    std::vector<uint64_t> missed_;
+    uint64_t totalMissed_;
+    Clock::time_point dueDeadline_;
+};
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef READ_ERROR_H
+#define READ_ERROR_H
+
+#include <cstdint>
+
+enum class ReadError : uint8_t {
+    None = 0x00,
+    IllegalFunction = 0x01,
+    IllegalDataAddress = 0x02,
+    IllegalDataValue = 0x03,
+    ServerDeviceFailure = 0x04,
+    Acknowledge = 0x05,
+    ServerDeviceBusy = 0x06,
+    MemoryParityError = 0x08,
+    GatewayPathUnavailable = 0x0A,
+    GatewayTargetFailed = 0x0B,
+    Exception = 0x7F,
+    NotConnected = 0x80,
+    InvalidCount,
+    SendFailed,
+    IoError,
+    Timeout,
+    BadLength,
+    SlaveMismatch,
+    UnexpectedFunction,
+    CrcMismatch,
+    PortNotFound,
+    PortDisconnected,
+    Offline,
+    TcpNotConnected,
+    TcpSendFailed,
+    TcpConnectionLost
+};
+
+inline ReadError exceptionError(uint8_t code) {
+    switch (code) {
+        case 0x01: case 0x02: case 0x03: case 0x04: case 0x05:
+        case 0x06: case 0x08: case 0x0A: case 0x0B:
+            return static_cast<ReadError>(code);
+        default:
+            return ReadError::Exception;
+    }
+}
+
+inline const char* readErrorMessage(ReadError error) {
+    switch (error) {
+        case ReadError::None: return "";
+        case ReadError::IllegalFunction: return "Modbus异常响应: 非法功能码";
+        case ReadError::IllegalDataAddress: return "Modbus异常响应: 非法数据地址";
+        case ReadError::IllegalDataValue: return "Modbus异常响应: 非法数据值";
+        case ReadError::ServerDeviceFailure: return "Modbus异常响应: 从站设备故障";
+        case ReadError::Acknowledge: return "Modbus异常响应: 已确认";
+        case ReadError::ServerDeviceBusy: return "Modbus异常响应: 从站设备忙";
+        case ReadError::MemoryParityError: return "Modbus异常响应: 存储奇偶校验错误";
+        case ReadError::GatewayPathUnavailable: return "Modbus异常响应: 网关路径不可用";
+        case ReadError::GatewayTargetFailed: return "Modbus异常响应: 网关目标设备无响应";
+        case ReadError::Exception: return "Modbus异常响应";
+        case ReadError::NotConnected: return "未连接设备";
+        case ReadError::InvalidCount: return "寄存器数量超出范围";
+        case ReadError::SendFailed: return "发送读取请求失败";
+        case ReadError::IoError: return "串口读写错误";
+        case ReadError::Timeout: return "读取响应超时";
+        case ReadError::BadLength: return "数据长度不正确";
+        case ReadError::SlaveMismatch: return "从站地址不匹配";
+        case ReadError::UnexpectedFunction: return "未知功能码响应";
+        case ReadError::CrcMismatch: return "CRC校验失败";
+        case ReadError::PortNotFound: return "未找到串口";
+        case ReadError::PortDisconnected: return "串口未连接";
+        case ReadError::Offline: return "从站离线";
+        case ReadError::TcpNotConnected: return "Modbus TCP未连接";
+        case ReadError::TcpSendFailed: return "Modbus TCP发送失败";
+        case ReadError::TcpConnectionLost: return "Modbus TCP连接中断";
+    }
+    return "未知错误";
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef RTT_ESTIMATOR_H
+#define RTT_ESTIMATOR_H
+
+#include <algorithm>
+#include <chrono>
+
+class RttEstimator {
+public:
+    using Duration = std::chrono::microseconds;
+
+    RttEstimator() : srtt_(0), rttvar_(0), rto_(0) {}
+
+    bool hasSamples() const {
+        return srtt_ > Duration::zero();
+    }
+
+    Duration smoothed() const {
+        return srtt_;
+    }
+
+    Duration timeout(Duration minimum, Duration maximum) const {
+        if (rto_ <= Duration::zero()) {
+            return maximum;
+        }
+        return std::min(std::max(rto_, minimum), maximum);
+    }
+
+    void sample(Duration rtt) {
+        rtt = std::max(rtt, Duration(1));
+        if (!hasSamples()) {
+            srtt_ = rtt;
+            rttvar_ = rtt / 2;
+        } else {
+            Duration delta = srtt_ > rtt ? srtt_ - rtt : rtt - srtt_;
+            rttvar_ = (rttvar_ * 3 + delta) / 4;
+            srtt_ = (srtt_ * 7 + rtt) / 8;
+        }
+        rto_ = srtt_ + rttvar_ * 4;
+    }
+
+private:
+    Duration srtt_;
+    Duration rttvar_;
+    Duration rto_;
+};
+
+#endif
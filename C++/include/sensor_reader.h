@@ -6,31 +6,69 @@
 #include <cstdint>
 #include <memory>
 #include <functional>
+#include <tuple>
+#include <chrono>
+#include <atomic>
+#include <future>
+#include <thread>
+
+#include "config.h"
+#include "poll_planner.h"
+#include "poll_plan.h"
+#include "circuit_breaker.h"
+#include "cycle_timer.h"
+#include "read_error.h"
 
 struct SensorData {
-    std::string name;
+    uint32_t sensor_id;
     uint8_t slave_id;
     bool error;
+    bool offline;
+    ReadError error_code;
     double temperature;
     double humidity;
-    std::string error_message;
+};
+
+struct SerialOptions {
+    bool rs485;
+    bool low_latency;
+    int rs485_delay_before_send;
+    int rs485_delay_after_send;
 };
 
 class SensorReader {
 public:
+    using SensorList = std::vector<std::tuple<uint8_t, uint16_t, uint16_t, double, double, std::string>>;
+    using BlockCompletion = std::function<void(size_t index, const uint16_t* values, ReadError error)>;
+
     SensorReader(const std::string& port, int baudrate, int dataBits,
                  int stopBits, char parity, int timeoutMs);
+    SensorReader(const std::string& host, int tcpPort, int timeoutMs, int maxInFlight);
     ~SensorReader();
 
     bool connect();
     void disconnect();
     bool isConnected() const;
+    int nativeHandle() const;
+    int timeoutMs() const;
+    std::chrono::microseconds frameGap(uint8_t slaveId) const;
+    void setSlaveGap(uint8_t slaveId, std::chrono::microseconds gap);
+    void setSerialOptions(const SerialOptions& options);
+    void setTimeoutBounds(std::chrono::microseconds minimum, std::chrono::microseconds maximum);
+    std::chrono::microseconds responseTimeout(uint8_t slaveId, size_t responseLength) const;
+    void recordResponse(uint8_t slaveId, size_t responseLength, std::chrono::microseconds elapsed);
+    void recordTimeout(uint8_t slaveId, bool partial);
+    void setBreakerOptions(const BreakerOptions& options);
+    bool shouldPoll(uint8_t slaveId);
+    bool isSlaveOffline(uint8_t slaveId) const;
 
+    bool readRegisters(uint8_t slaveId, uint8_t funcCode, uint16_t start, uint16_t count,
+                       uint16_t* values, ReadError& error);
+    void readRegisterBlocks(const std::vector<const ReadBlock*>& blocks, const BlockCompletion& done);
     SensorData readSensor(uint8_t slaveId, uint16_t tempReg,
-                          uint16_t humiReg, double tempScale,
-                          double humiScale, const std::string& sensorName);
-    std::vector<SensorData> readAllSensors(
-        const std::vector<std::tuple<uint8_t, uint16_t, uint16_t, double, double, std::string>>& sensors);
+                          uint16_t humiReg, double tempScale, double humiScale);
+    std::vector<SensorData> readAllSensors(const SensorList& sensors);
+    void readAllSensors(const SensorList& sensors, std::vector<SensorData>& results);
 
     static std::string getDefaultPort();
 
@@ -39,22 +77,137 @@ private:
     std::unique_ptr<Impl> impl_;
 };
 
+class ModbusReactor;
+
 class MultiPortReader {
 public:
+    using SensorList = std::vector<std::tuple<uint8_t, uint16_t, uint16_t, double, double,
+                                              std::string, std::string, uint8_t,
+                                              PointFormat, PointFormat>>;
+    using SensorEntry = SensorList::value_type;
+    using SensorCallback = std::function<void(SensorData data)>;
+    using SensorsCallback = std::function<void(std::vector<SensorData> results)>;
+
     MultiPortReader();
     ~MultiPortReader();
 
     bool addPort(const std::string& name, const std::string& port, int baudrate,
                  int dataBits, int stopBits, char parity, int timeoutMs);
+    bool addTcpPort(const std::string& name, const std::string& host, int tcpPort,
+                    int timeoutMs, int maxInFlight);
     bool connectAll();
     void disconnectAll();
-    std::vector<SensorData> readAllSensors(
-        const std::vector<std::tuple<uint8_t, uint16_t, uint16_t, double, double, std::string, std::string>>& sensors);
+    void setPollMode(PollMode mode);
+    PollMode getPollMode() const;
+    void setPlannerOptions(const PlannerOptions& options);
+    bool setSlaveGap(const std::string& portName, uint8_t slaveId, std::chrono::microseconds gap);
+    bool setSerialOptions(const std::string& portName, const SerialOptions& options);
+    bool setTimeoutBounds(const std::string& portName, std::chrono::microseconds minimum,
+                          std::chrono::microseconds maximum);
+    void setBreakerOptions(const BreakerOptions& options);
+    void setRealtimeOptions(const RealtimeOptions& options);
+    std::vector<SensorData> readAllSensors(const SensorList& sensors);
+    void readAllSensors(const SensorList& sensors, std::vector<SensorData>& results);
+    PollPlan compilePlan(const std::vector<SensorConfig>& sensors) const;
+    void readSensors(const PollPlan& plan, const std::vector<size_t>& due, std::vector<SensorData>& results);
+    void readSensorsAsync(const PollPlan& plan, const std::vector<size_t>& due, SensorsCallback done);
+    bool startEventLoop();
+    void stopEventLoop();
+    size_t pollEvents(int timeoutMs);
+    int eventHandle();
+    void readSensorAsync(const SensorEntry& sensor, SensorCallback done);
+    std::future<SensorData> readSensorAsync(const SensorEntry& sensor);
+    void readAllSensorsAsync(const SensorList& sensors, SensorsCallback done);
+    std::future<std::vector<SensorData>> readAllSensorsAsync(const SensorList& sensors);
     bool isPortConnected(const std::string& portName) const;
 
 private:
+    class PortWorker;
+    struct AsyncRead;
+    struct ReactorTarget;
+    using BlockDone = std::function<void(const uint16_t* values, ReadError error)>;
+
+    struct CachedPlan {
+        SensorList sensors;
+        std::shared_ptr<const PollPlan> plan;
+    };
+
+    struct CycleContext {
+        const PollPlan* plan;
+        std::vector<SensorData>* results;
+        const std::vector<size_t>* resultIndex;
+    };
+
+    void beginCycle(const PollPlan& plan, const std::vector<size_t>& due, std::vector<SensorData>& results,
+                    std::vector<size_t>& resultIndex);
+    const std::shared_ptr<const PollPlan>& cachedPlan(const SensorList& sensors);
+    PortWorker& worker(size_t portIndex);
+    bool ensureReactor();
+    void registerChannel(size_t portIndex);
+    void submitBlock(size_t portIndex, const ReadBlock& block, BlockDone done);
+    void startAsyncRead(const std::shared_ptr<AsyncRead>& read);
+    void finishAsyncBlock(const std::shared_ptr<AsyncRead>& read, size_t blockIndex,
+                          const uint16_t* values, ReadError error);
+
+    void readPortBlocks(size_t portIndex);
+    void dispatchBlocks();
+    void readWithReactor();
+
     std::vector<std::unique_ptr<SensorReader>> readers_;
     std::vector<std::string> portNames_;
+    std::vector<std::unique_ptr<PortWorker>> workers_;
+    std::unique_ptr<ModbusReactor> reactor_;
+    std::vector<int> reactorChannels_;
+    PlannerOptions plannerOptions_;
+    BreakerOptions breakerOptions_;
+    RealtimeOptions realtimeOptions_;
+    PollMode pollMode_;
+    std::thread loopThread_;
+    std::atomic<bool> loopRunning_;
+    std::atomic<size_t> asyncPending_;
+    std::vector<size_t> allSensors_;
+    std::vector<size_t> resultIndex_;
+    std::vector<CachedPlan> planCache_;
+    size_t planCacheNext_;
+    std::vector<std::vector<size_t>> portBlocks_;
+    std::vector<std::vector<const ReadBlock*>> portBlockPointers_;
+    std::vector<ReactorTarget> reactorTargets_;
+    std::vector<size_t> networkPorts_;
+    CycleContext cycle_;
 };
 
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+
+class SensorReadAwaitable {
+public:
+    SensorReadAwaitable(MultiPortReader& reader, MultiPortReader::SensorList sensors)
+        : reader_(reader), sensors_(std::move(sensors)) {}
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        reader_.readAllSensorsAsync(sensors_, [this, handle](std::vector<SensorData> results) {
+            results_ = std::move(results);
+            handle.resume();
+        });
+    }
+
+    std::vector<SensorData> await_resume() {
+        return std::move(results_);
+    }
+
+private:
+    MultiPortReader& reader_;
+    MultiPortReader::SensorList sensors_;
+    std::vector<SensorData> results_;
+};
+
+inline SensorReadAwaitable readSensorsAwaitable(MultiPortReader& reader, MultiPortReader::SensorList sensors) {
+    return SensorReadAwaitable(reader, std::move(sensors));
+}
+#endif
+
 #endif
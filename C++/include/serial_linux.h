@@ -0,0 +1,12 @@
+#ifndef SERIAL_LINUX_H
+#define SERIAL_LINUX_H
+
+namespace serial {
+
+bool setCustomBaudrate(int fd, int baudrate);
+bool setLowLatency(int fd);
+bool enableRs485(int fd, int delayBeforeSendMs, int delayAfterSendMs);
+
+} // namespace serial
+
+#endif
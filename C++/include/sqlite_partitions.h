@@ -0,0 +1,41 @@
+#ifndef SQLITE_PARTITIONS_H
+#define SQLITE_PARTITIONS_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "config.h"
+
+class SQLitePartitions {
+public:
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    struct Partition {
+        TimePoint start;
+        TimePoint end;
+        std::string path;
+    };
+
+    SQLitePartitions(const std::string& basePath, PartitionPeriod period);
+
+    Partition at(TimePoint time) const;
+    std::vector<Partition> list() const;
+    std::vector<Partition> covering(TimePoint from, TimePoint to) const;
+    size_t dropBefore(TimePoint cutoff, const std::string& keepPath) const;
+
+private:
+    TimePoint startOf(TimePoint time) const;
+    TimePoint endOf(TimePoint start) const;
+    std::string pathFor(TimePoint start) const;
+    bool parse(const std::string& fileName, Partition& partition) const;
+
+    std::string basePath_;
+    std::string directory_;
+    std::string stem_;
+    std::string extension_;
+    PartitionPeriod period_;
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef STORAGE_WRITER_H
+#define STORAGE_WRITER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bounded_queue.h"
+#include "config.h"
+#include "data_storage.h"
+
+class StorageWriter {
+public:
+    StorageWriter(std::unique_ptr<DataStorage> storage, const StorageConfig& config);
+    ~StorageWriter();
+
+    void submit(const std::vector<SensorRecord>& records);
+    void stop();
+
+    size_t queueDepth() const;
+    size_t maxQueueDepth() const;
+    size_t queueCapacity() const;
+    uint64_t written() const;
+    uint64_t failed() const;
+    uint64_t dropped() const;
+    uint64_t spilled() const;
+    uint64_t duplicates() const;
+
+private:
+    void run();
+    void write(const std::vector<SensorRecord>& batch);
+    void wakeWriter();
+    void pushBlocking(const SensorRecord& record);
+    void drainSpill();
+    bool replaySpill();
+
+    std::unique_ptr<DataStorage> storage_;
+    BoundedQueue<SensorRecord> queue_;
+    BoundedQueue<SensorRecord> spillQueue_;
+    Backpressure policy_;
+    size_t batchSize_;
+    std::chrono::microseconds commitInterval_;
+    std::string spillPath_;
+    std::string replayPath_;
+    SensorRecord evicted_;
+    SensorRecord spillRecord_;
+    std::mutex mutex_;
+    std::condition_variable dataReady_;
+    std::condition_variable spaceReady_;
+    bool spillPending_;
+    std::atomic<bool> stopping_;
+    std::atomic<size_t> maxDepth_;
+    std::atomic<uint64_t> written_;
+    std::atomic<uint64_t> failed_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<uint64_t> spilled_;
+    std::thread thread_;
+};
+
+#endif
@@ -7,6 +7,8 @@
 
 namespace {
 
+constexpr int kDefaultOfflineFailures = 3;
+
 std::string trim(const std::string& str) {
     size_t start = str.find_first_not_of(" \t\n\r");
     if (start == std::string::npos) return "";
@@ -19,28 +21,38 @@ std::string extractStringValue(const std::string& json, const std::string& key)
     size_t keyPos = json.find(searchKey);
     if (keyPos == std::string::npos) return "";
 
-    size_t colonPos = json.find(":", keyPos);
+    size_t colonPos = json.find(":", keyPos + searchKey.size());
     if (colonPos == std::string::npos) return "";
 
-    size_t valueStart = json.find("\"", colonPos);
+    size_t valueStart = json.find_first_not_of(" \t\n\r", colonPos + 1);
     if (valueStart == std::string::npos) return "";
 
+    if (json[valueStart] != '"') {
+        size_t valueEnd = json.find_first_of(",}] \t\n\r", valueStart);
+        return trim(json.substr(valueStart, valueEnd - valueStart));
+    }
+
     size_t valueEnd = json.find("\"", valueStart + 1);
     if (valueEnd == std::string::npos) return "";
 
     return json.substr(valueStart + 1, valueEnd - valueStart - 1);
 }
 
-int extractIntValue(const std::string& json, const std::string& key) {
+int extractIntValue(const std::string& json, const std::string& key, int defaultValue = 0) {
     std::string value = extractStringValue(json, key);
-    if (value.empty()) return 0;
+    if (value.empty()) return defaultValue;
     try {
         return std::stoi(value);
     } catch (...) {
-        return 0;
+        return defaultValue;
     }
 }
 
+bool extractBoolValue(const std::string& json, const std::string& key) {
+    std::string value = extractStringValue(json, key);
+    return value == "true" || value == "1";
+}
+
 double extractDoubleValue(const std::string& json, const std::string& key) {
     std::string value = extractStringValue(json, key);
     if (value.empty()) return 0.0;
@@ -51,6 +63,11 @@ double extractDoubleValue(const std::string& json, const std::string& key) {
     }
 }
 
+TransportType parseTransportType(const std::string& typeStr) {
+    if (typeStr == "tcp") return TransportType::TCP;
+    return TransportType::RTU;
+}
+
 std::vector<PortConfig> extractPortArray(const std::string& json) {
     std::vector<PortConfig> ports;
     std::string portArrayStart = "\"ports\"";
@@ -79,6 +96,16 @@ std::vector<PortConfig> extractPortArray(const std::string& json) {
         std::string parityStr = extractStringValue(objectContent, "parity");
         port.parity = parityStr.empty() ? 'N' : parityStr[0];
         port.timeout = extractDoubleValue(objectContent, "timeout");
+        port.min_timeout = extractDoubleValue(objectContent, "min_timeout");
+        port.max_timeout = extractDoubleValue(objectContent, "max_timeout");
+        port.rs485 = extractBoolValue(objectContent, "rs485");
+        port.low_latency = extractBoolValue(objectContent, "low_latency");
+        port.rs485_delay_before_send = extractIntValue(objectContent, "rs485_delay_before_send");
+        port.rs485_delay_after_send = extractIntValue(objectContent, "rs485_delay_after_send");
+        port.transport = parseTransportType(extractStringValue(objectContent, "type"));
+        port.host = extractStringValue(objectContent, "host");
+        port.tcp_port = extractIntValue(objectContent, "tcp_port");
+        port.max_in_flight = extractIntValue(objectContent, "max_in_flight");
 
         ports.push_back(port);
         objectStart = objectEnd + 1;
@@ -87,6 +114,41 @@ std::vector<PortConfig> extractPortArray(const std::string& json) {
     return ports;
 }
 
+std::vector<int> parseCpuList(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        item = trim(item);
+        if (item.empty()) continue;
+        try {
+            int cpu = std::stoi(item);
+            if (cpu >= 0) cpus.push_back(cpu);
+        } catch (...) {
+            std::cerr << "无效的CPU编号: " << item << std::endl;
+        }
+    }
+    return cpus;
+}
+
+PointFormat extractPointFormat(const std::string& json, const std::string& typeKey,
+                               const std::string& orderKey) {
+    std::string typeText = extractStringValue(json, typeKey);
+    if (typeText.empty()) typeText = extractStringValue(json, "data_type");
+    std::string orderText = extractStringValue(json, orderKey);
+    if (orderText.empty()) orderText = extractStringValue(json, "word_order");
+
+    DataType type = DataType::UInt16;
+    WordOrder order = WordOrder::ABCD;
+    if (!typeText.empty() && !parseDataType(typeText, type)) {
+        std::cerr << "未知的数据类型: " << typeText << "，使用uint16" << std::endl;
+    }
+    if (!orderText.empty() && !parseWordOrder(orderText, order)) {
+        std::cerr << "未知的字节序: " << orderText << "，使用ABCD" << std::endl;
+    }
+    return pointFormat(type, order);
+}
+
 std::vector<SensorConfig> extractSensorArray(const std::string& json) {
     std::vector<SensorConfig> sensors;
     std::string sensorArrayStart = "\"sensors\"";
@@ -114,6 +176,11 @@ std::vector<SensorConfig> extractSensorArray(const std::string& json) {
         sensor.temp_scale = extractDoubleValue(objectContent, "temp_scale");
         sensor.humi_scale = extractDoubleValue(objectContent, "humi_scale");
         sensor.port_name = extractStringValue(objectContent, "port_name");
+        sensor.function_code = static_cast<uint8_t>(extractIntValue(objectContent, "function_code"));
+        sensor.inter_frame_gap_ms = extractDoubleValue(objectContent, "inter_frame_gap_ms");
+        sensor.temp_format = extractPointFormat(objectContent, "temp_type", "temp_order");
+        sensor.humi_format = extractPointFormat(objectContent, "humi_type", "humi_order");
+        sensor.poll_interval = extractDoubleValue(objectContent, "poll_interval");
 
         sensors.push_back(sensor);
         objectStart = objectEnd + 1;
@@ -130,6 +197,43 @@ StorageType parseStorageType(const std::string& typeStr) {
     return StorageType::SQLite;
 }
 
+Backpressure parseBackpressure(const std::string& policyStr) {
+    if (policyStr == "block") return Backpressure::Block;
+    if (policyStr == "spill") return Backpressure::Spill;
+    return Backpressure::DropOldest;
+}
+
+SQLiteSchema parseSQLiteSchema(const std::string& schemaStr) {
+    if (schemaStr == "compact") return SQLiteSchema::Compact;
+    return SQLiteSchema::Legacy;
+}
+
+PartitionPeriod parsePartitionPeriod(const std::string& periodStr) {
+    if (periodStr == "day") return PartitionPeriod::Day;
+    if (periodStr == "week") return PartitionPeriod::Week;
+    return PartitionPeriod::None;
+}
+
+std::string parseJournalMode(const std::string& modeStr) {
+    for (const char* mode : {"delete", "truncate", "persist", "memory", "wal", "off"}) {
+        if (modeStr == mode) return modeStr;
+    }
+    return "wal";
+}
+
+std::string parseSynchronous(const std::string& levelStr) {
+    for (const char* level : {"off", "normal", "full", "extra"}) {
+        if (levelStr == level) return levelStr;
+    }
+    return "normal";
+}
+
+PollMode parsePollMode(const std::string& modeStr) {
+    if (modeStr == "sequential") return PollMode::Sequential;
+    if (modeStr == "reactor") return PollMode::Reactor;
+    return PollMode::Parallel;
+}
+
 } // namespace
 
 AppConfig Config::load(const std::string& filename) {
@@ -147,17 +251,61 @@ AppConfig Config::load(const std::string& filename) {
     AppConfig& appConfig = config.config_;
 
     appConfig.modbus.ports = extractPortArray(jsonContent);
+    if (appConfig.modbus.ports.empty() && !extractStringValue(jsonContent, "port").empty()) {
+        PortConfig port;
+        port.transport = TransportType::RTU;
+        port.tcp_port = 0;
+        port.max_in_flight = 0;
+        port.port = extractStringValue(jsonContent, "port");
+        port.name = port.port;
+        port.baudrate = extractIntValue(jsonContent, "baudrate");
+        port.data_bits = extractIntValue(jsonContent, "data_bits");
+        port.stop_bits = extractIntValue(jsonContent, "stop_bits");
+        std::string parityStr = extractStringValue(jsonContent, "parity");
+        port.parity = parityStr.empty() ? 'N' : parityStr[0];
+        port.timeout = extractDoubleValue(jsonContent, "timeout");
+        port.min_timeout = extractDoubleValue(jsonContent, "min_timeout");
+        port.max_timeout = extractDoubleValue(jsonContent, "max_timeout");
+        port.rs485 = extractBoolValue(jsonContent, "rs485");
+        port.low_latency = extractBoolValue(jsonContent, "low_latency");
+        port.rs485_delay_before_send = extractIntValue(jsonContent, "rs485_delay_before_send");
+        port.rs485_delay_after_send = extractIntValue(jsonContent, "rs485_delay_after_send");
+        appConfig.modbus.ports.push_back(port);
+    }
     appConfig.modbus.read_interval = extractIntValue(jsonContent, "read_interval");
+    appConfig.modbus.poll_mode = parsePollMode(extractStringValue(jsonContent, "poll_mode"));
+    appConfig.modbus.coalesce_max_gap = extractIntValue(jsonContent, "coalesce_max_gap");
+    appConfig.modbus.coalesce_max_registers = extractIntValue(jsonContent, "coalesce_max_registers");
+    appConfig.modbus.offline_failures = extractIntValue(jsonContent, "offline_failures", kDefaultOfflineFailures);
+    appConfig.modbus.offline_retry = extractDoubleValue(jsonContent, "offline_retry");
+    appConfig.modbus.offline_retry_max = extractDoubleValue(jsonContent, "offline_retry_max");
+    appConfig.modbus.realtime_priority = extractIntValue(jsonContent, "realtime_priority");
+    appConfig.modbus.cpu_affinity = parseCpuList(extractStringValue(jsonContent, "cpu_affinity"));
     appConfig.modbus.sensors = extractSensorArray(jsonContent);
 
     std::string storageTypeStr = extractStringValue(jsonContent, "storage_type");
     appConfig.storage.type = parseStorageType(storageTypeStr);
     appConfig.storage.sqlite_path = extractStringValue(jsonContent, "storage_sqlite_path");
+    appConfig.storage.sqlite_schema = parseSQLiteSchema(extractStringValue(jsonContent, "storage_sqlite_schema"));
+    appConfig.storage.sqlite_partition = parsePartitionPeriod(extractStringValue(jsonContent, "storage_sqlite_partition"));
+    appConfig.storage.sqlite_retention_days = extractIntValue(jsonContent, "storage_sqlite_retention_days");
+    appConfig.storage.sqlite_rollups = extractBoolValue(jsonContent, "storage_sqlite_rollups");
+    appConfig.storage.sqlite_journal_mode = parseJournalMode(extractStringValue(jsonContent, "storage_sqlite_journal_mode"));
+    appConfig.storage.sqlite_synchronous = parseSynchronous(extractStringValue(jsonContent, "storage_sqlite_synchronous"));
+    appConfig.storage.sqlite_page_size = extractIntValue(jsonContent, "storage_sqlite_page_size");
+    appConfig.storage.sqlite_cache_kb = extractIntValue(jsonContent, "storage_sqlite_cache_kb");
+    appConfig.storage.sqlite_mmap_mb = extractIntValue(jsonContent, "storage_sqlite_mmap_mb");
+    appConfig.storage.sqlite_checkpoint_pages = extractIntValue(jsonContent, "storage_sqlite_checkpoint_pages");
     appConfig.storage.influxdb_url = extractStringValue(jsonContent, "storage_influxdb_url");
     appConfig.storage.influxdb_token = extractStringValue(jsonContent, "storage_influxdb_token");
     appConfig.storage.influxdb_org = extractStringValue(jsonContent, "storage_influxdb_org");
     appConfig.storage.influxdb_bucket = extractStringValue(jsonContent, "storage_influxdb_bucket");
     appConfig.storage.csv_path = extractStringValue(jsonContent, "storage_csv_path");
+    appConfig.storage.queue_capacity = static_cast<size_t>(std::max(0, extractIntValue(jsonContent, "storage_queue_capacity")));
+    appConfig.storage.batch_size = static_cast<size_t>(std::max(0, extractIntValue(jsonContent, "storage_batch_size")));
+    appConfig.storage.commit_interval = extractDoubleValue(jsonContent, "storage_commit_interval");
+    appConfig.storage.backpressure = parseBackpressure(extractStringValue(jsonContent, "storage_backpressure"));
+    appConfig.storage.spill_path = extractStringValue(jsonContent, "storage_spill_path");
 
     config.applyDefaults();
     return appConfig;
@@ -165,6 +313,10 @@ AppConfig Config::load(const std::string& filename) {
 
 AppConfig Config::loadDefault() {
     Config config;
+    config.config_ = AppConfig{};
+    config.config_.modbus.poll_mode = PollMode::Parallel;
+    config.config_.storage.backpressure = Backpressure::DropOldest;
+    config.config_.modbus.offline_failures = kDefaultOfflineFailures;
     config.applyDefaults();
     return config.config_;
 }
@@ -179,6 +331,9 @@ void Config::applyDefaults() {
 
     if (cfg.modbus.ports.empty()) {
         PortConfig defaultPort;
+        defaultPort.transport = TransportType::RTU;
+        defaultPort.tcp_port = 0;
+        defaultPort.max_in_flight = 0;
 #ifdef _WIN32
         defaultPort.name = "COM1";
         defaultPort.port = "COM1";
@@ -191,14 +346,50 @@ void Config::applyDefaults() {
         defaultPort.stop_bits = 1;
         defaultPort.parity = 'N';
         defaultPort.timeout = 1.0;
+        defaultPort.min_timeout = 0.0;
+        defaultPort.max_timeout = 0.0;
+        defaultPort.rs485 = false;
+        defaultPort.low_latency = false;
+        defaultPort.rs485_delay_before_send = 0;
+        defaultPort.rs485_delay_after_send = 0;
         cfg.modbus.ports.push_back(defaultPort);
     }
 
+    for (auto& port : cfg.modbus.ports) {
+        if (port.transport == TransportType::TCP) {
+            if (port.port.empty()) port.port = port.host;
+            if (port.tcp_port == 0) port.tcp_port = 502;
+            if (port.max_in_flight <= 0) port.max_in_flight = 1;
+        }
+        if (port.name.empty()) port.name = port.port;
+        if (port.baudrate == 0) port.baudrate = 9600;
+        if (port.data_bits == 0) port.data_bits = 8;
+        if (port.stop_bits == 0) port.stop_bits = 1;
+        if (port.timeout == 0.0) port.timeout = 1.0;
+        if (port.max_timeout <= 0.0) port.max_timeout = port.timeout * 2;
+        if (port.min_timeout <= 0.0) port.min_timeout = 0.02;
+        if (port.min_timeout > port.max_timeout) port.min_timeout = port.max_timeout;
+        if (port.rs485_delay_before_send < 0) port.rs485_delay_before_send = 0;
+        if (port.rs485_delay_after_send < 0) port.rs485_delay_after_send = 0;
+    }
+
     if (cfg.modbus.read_interval == 0) cfg.modbus.read_interval = 2;
+    if (cfg.modbus.coalesce_max_gap < 0) cfg.modbus.coalesce_max_gap = 0;
+    if (cfg.modbus.coalesce_max_registers <= 0 || cfg.modbus.coalesce_max_registers > 125) {
+        cfg.modbus.coalesce_max_registers = 125;
+    }
+    if (cfg.modbus.realtime_priority < 0) cfg.modbus.realtime_priority = 0;
+    if (cfg.modbus.realtime_priority > 99) cfg.modbus.realtime_priority = 99;
+    if (cfg.modbus.offline_retry <= 0.0) cfg.modbus.offline_retry = 10.0;
+    if (cfg.modbus.offline_retry_max < cfg.modbus.offline_retry) {
+        cfg.modbus.offline_retry_max = std::max(300.0, cfg.modbus.offline_retry);
+    }
 
     for (auto& sensor : cfg.modbus.sensors) {
         if (sensor.temp_scale == 0.0) sensor.temp_scale = 0.1;
+        if (sensor.poll_interval <= 0.0) sensor.poll_interval = cfg.modbus.read_interval;
         if (sensor.humi_scale == 0.0) sensor.humi_scale = 0.1;
+        if (sensor.function_code != 0x03 && sensor.function_code != 0x04) sensor.function_code = 0x03;
         if (sensor.port_name.empty() && !cfg.modbus.ports.empty()) {
             sensor.port_name = cfg.modbus.ports[0].name;
         }
@@ -210,16 +401,49 @@ void Config::applyDefaults() {
     if (cfg.storage.sqlite_path.empty()) {
         cfg.storage.sqlite_path = "sensor_data.db";
     }
+    if (cfg.storage.sqlite_journal_mode.empty()) {
+        cfg.storage.sqlite_journal_mode = "wal";
+    }
+    if (cfg.storage.sqlite_synchronous.empty()) {
+        cfg.storage.sqlite_synchronous = "normal";
+    }
+    if (cfg.storage.sqlite_page_size <= 0) {
+        cfg.storage.sqlite_page_size = 4096;
+    }
+    if (cfg.storage.sqlite_cache_kb <= 0) {
+        cfg.storage.sqlite_cache_kb = 8192;
+    }
+    if (cfg.storage.sqlite_mmap_mb < 0) {
+        cfg.storage.sqlite_mmap_mb = 0;
+    }
+    if (cfg.storage.sqlite_retention_days < 0) {
+        cfg.storage.sqlite_retention_days = 0;
+    }
+    if (cfg.storage.sqlite_checkpoint_pages <= 0) {
+        cfg.storage.sqlite_checkpoint_pages = 1000;
+    }
     if (cfg.storage.csv_path.empty()) {
         cfg.storage.csv_path = "sensor_data.csv";
     }
     if (cfg.storage.influxdb_url.empty()) {
         cfg.storage.influxdb_url = "http://localhost:8086";
     }
+    if (cfg.storage.queue_capacity == 0) {
+        cfg.storage.queue_capacity = 8192;
+    }
+    if (cfg.storage.batch_size == 0) {
+        cfg.storage.batch_size = 256;
+    }
+    if (cfg.storage.commit_interval <= 0.0) {
+        cfg.storage.commit_interval = 1.0;
+    }
+    if (cfg.storage.spill_path.empty()) {
+        cfg.storage.spill_path = "storage_spill.csv";
+    }
 }
 
-void Config::print() const {
-    const AppConfig& cfg = config_;
+void Config::print(const AppConfig& config) {
+    const AppConfig& cfg = config;
 
     std::cout << "配置信息:" << std::endl;
     std::cout << "  串口数量: " << cfg.modbus.ports.size() << std::endl;
@@ -227,15 +451,49 @@ void Config::print() const {
     for (size_t i = 0; i < cfg.modbus.ports.size(); ++i) {
         const auto& port = cfg.modbus.ports[i];
         std::cout << "  串口" << (i + 1) << ": " << port.name << std::endl;
+        if (port.transport == TransportType::TCP) {
+            std::cout << "    Modbus TCP: " << port.host << ":" << port.tcp_port << std::endl;
+            std::cout << "    最大并发请求: " << port.max_in_flight << std::endl;
+            std::cout << "    超时: " << port.timeout << "秒" << std::endl;
+            continue;
+        }
         std::cout << "    端口: " << port.port << std::endl;
         std::cout << "    波特率: " << port.baudrate << std::endl;
         std::cout << "    数据位: " << port.data_bits << std::endl;
         std::cout << "    停止位: " << port.stop_bits << std::endl;
         std::cout << "    校验位: " << port.parity << std::endl;
         std::cout << "    超时: " << port.timeout << "秒" << std::endl;
+        std::cout << "    响应超时范围: " << port.min_timeout << " - " << port.max_timeout << "秒" << std::endl;
+        if (port.rs485 || port.low_latency) {
+            std::cout << "    串口模式:" << (port.rs485 ? " RS485" : "")
+                      << (port.low_latency ? " 低延迟" : "") << std::endl;
+        }
     }
 
     std::cout << "  读取间隔: " << cfg.modbus.read_interval << "秒" << std::endl;
+    std::cout << "  寄存器合并: 最大间隔 " << cfg.modbus.coalesce_max_gap
+              << ", 最大数量 " << cfg.modbus.coalesce_max_registers << std::endl;
+    if (cfg.modbus.offline_failures > 0) {
+        std::cout << "  离线判定: 连续失败 " << cfg.modbus.offline_failures << " 次, 重试间隔 "
+                  << cfg.modbus.offline_retry << " - " << cfg.modbus.offline_retry_max << "秒" << std::endl;
+    } else {
+        std::cout << "  离线判定: 禁用" << std::endl;
+    }
+    if (cfg.modbus.realtime_priority > 0 || !cfg.modbus.cpu_affinity.empty()) {
+        std::cout << "  实时调度: SCHED_FIFO优先级 " << cfg.modbus.realtime_priority << ", CPU ";
+        if (cfg.modbus.cpu_affinity.empty()) std::cout << "不限";
+        for (size_t i = 0; i < cfg.modbus.cpu_affinity.size(); ++i) {
+            std::cout << (i ? "," : "") << cfg.modbus.cpu_affinity[i];
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "  轮询模式: ";
+    switch (cfg.modbus.poll_mode) {
+        case PollMode::Sequential: std::cout << "顺序"; break;
+        case PollMode::Parallel: std::cout << "并行"; break;
+        case PollMode::Reactor: std::cout << "单线程epoll"; break;
+    }
+    std::cout << std::endl;
 
     std::cout << "  存储类型: ";
     switch (cfg.storage.type) {
@@ -245,6 +503,39 @@ void Config::print() const {
         case StorageType::None: std::cout << "None"; break;
     }
     std::cout << std::endl;
+    if (cfg.storage.type == StorageType::SQLite) {
+        std::cout << "  SQLite: " << cfg.storage.sqlite_path
+                  << (cfg.storage.sqlite_schema == SQLiteSchema::Compact ? " (紧凑表结构)" : "")
+                  << ", journal_mode=" << cfg.storage.sqlite_journal_mode
+                  << ", synchronous=" << cfg.storage.sqlite_synchronous
+                  << ", 页大小 " << cfg.storage.sqlite_page_size << ", 缓存 " << cfg.storage.sqlite_cache_kb
+                  << "KB, mmap " << cfg.storage.sqlite_mmap_mb << "MB";
+        if (cfg.storage.sqlite_journal_mode == "wal") {
+            std::cout << ", WAL超过 " << cfg.storage.sqlite_checkpoint_pages << " 页后台检查点";
+        }
+        if (cfg.storage.sqlite_rollups) {
+            std::cout << ", 维护1分钟/1小时汇总表";
+        }
+        std::cout << std::endl;
+        if (cfg.storage.sqlite_partition != PartitionPeriod::None) {
+            std::cout << "  SQLite分区: 每" << (cfg.storage.sqlite_partition == PartitionPeriod::Day ? "天" : "周")
+                      << "一个数据库文件, ";
+            if (cfg.storage.sqlite_retention_days > 0) {
+                std::cout << "保留 " << cfg.storage.sqlite_retention_days << " 天";
+            } else {
+                std::cout << "永久保留";
+            }
+            std::cout << std::endl;
+        }
+    }
+    std::cout << "  存储队列: 容量 " << cfg.storage.queue_capacity << ", 每 " << cfg.storage.batch_size
+              << " 条或 " << cfg.storage.commit_interval << "秒提交一次, 队列满时";
+    switch (cfg.storage.backpressure) {
+        case Backpressure::Block: std::cout << "等待写入"; break;
+        case Backpressure::DropOldest: std::cout << "丢弃最旧记录"; break;
+        case Backpressure::Spill: std::cout << "溢写到 " << cfg.storage.spill_path; break;
+    }
+    std::cout << std::endl;
 
     std::cout << "  传感器数量: " << cfg.modbus.sensors.size() << std::endl;
 
@@ -253,14 +544,31 @@ void Config::print() const {
         std::cout << "  传感器" << (i + 1) << ": " << sensor.name
                   << " (从站地址: " << static_cast<int>(sensor.slave_id)
                   << ", 温度寄存器: 0x" << std::hex << sensor.temp_reg
-                  << ", 湿度寄存器: 0x" << sensor.humi_reg << std::dec << ")" << std::endl;
+                  << ", 湿度寄存器: 0x" << sensor.humi_reg << std::dec
+                  << ", 温度类型: " << dataTypeToString(sensor.temp_format.type)
+                  << "/" << wordOrderToString(sensor.temp_format.order)
+                  << ", 湿度类型: " << dataTypeToString(sensor.humi_format.type)
+                  << "/" << wordOrderToString(sensor.humi_format.order)
+                  << ", 轮询周期: " << sensor.poll_interval << "秒)" << std::endl;
     }
 }
 
-std::chrono::milliseconds Config::getTimeout() const {
-    return std::chrono::milliseconds(static_cast<long long>(config_.modbus.timeout * 1000));
+std::chrono::milliseconds Config::getTimeout(const PortConfig& port) {
+    return std::chrono::milliseconds(static_cast<long long>(port.timeout * 1000));
+}
+
+std::chrono::microseconds Config::getMinTimeout(const PortConfig& port) {
+    return std::chrono::microseconds(static_cast<long long>(port.min_timeout * 1000000));
+}
+
+std::chrono::microseconds Config::getMaxTimeout(const PortConfig& port) {
+    return std::chrono::microseconds(static_cast<long long>(port.max_timeout * 1000000));
+}
+
+std::chrono::seconds Config::getReadInterval(const AppConfig& config) {
+    return std::chrono::seconds(config.modbus.read_interval);
 }
 
-std::chrono::seconds Config::getReadInterval() const {
-    return std::chrono::seconds(config_.modbus.read_interval);
+std::chrono::microseconds Config::getPollInterval(const SensorConfig& sensor) {
+    return std::chrono::microseconds(static_cast<long long>(sensor.poll_interval * 1000000));
 }
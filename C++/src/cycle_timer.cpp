@@ -0,0 +1,122 @@
+#include "cycle_timer.h"
+#include <algorithm>
+#include <thread>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/mman.h>
+    #include <time.h>
+#endif
+
+namespace cycle {
+
+bool sleepUntil(Clock::time_point deadline) {
+#ifdef __linux__
+    auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch());
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(sinceEpoch.count() / 1000000000);
+    ts.tv_nsec = static_cast<long>(sinceEpoch.count() % 1000000000);
+    return clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == 0;
+#else
+    std::this_thread::sleep_until(deadline);
+    return true;
+#endif
+}
+
+bool applyRealtime(const RealtimeOptions& options) {
+    bool ok = true;
+#ifdef _WIN32
+    if (options.priority > 0 && !SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) {
+        ok = false;
+    }
+    if (!options.cpus.empty()) {
+        DWORD_PTR mask = 0;
+        for (int cpu : options.cpus) {
+            if (cpu >= 0 && cpu < static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+                mask |= static_cast<DWORD_PTR>(1) << cpu;
+            }
+        }
+        if (mask == 0 || SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+            ok = false;
+        }
+    }
+#else
+    if (options.priority > 0) {
+        struct sched_param param;
+        param.sched_priority = std::min(options.priority, sched_get_priority_max(SCHED_FIFO));
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+            ok = false;
+        }
+    }
+#ifdef __linux__
+    if (!options.cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : options.cpus) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &set);
+            }
+        }
+        if (CPU_COUNT(&set) == 0 || pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+            ok = false;
+        }
+    }
+#else
+    if (!options.cpus.empty()) {
+        ok = false;
+    }
+#endif
+#endif
+    return ok;
+}
+
+bool lockMemory() {
+#ifdef _WIN32
+    return true;
+#else
+    return mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+#endif
+}
+
+} // namespace cycle
+
+CycleStats::CycleStats()
+    : cycles_(0), overruns_(0), totalJitter_(0), maxJitter_(0), lastJitter_(0) {}
+
+void CycleStats::recordStart(cycle::Clock::time_point deadline, cycle::Clock::time_point actual) {
+    Duration jitter = std::chrono::duration_cast<Duration>(actual - deadline);
+    if (jitter < Duration::zero()) jitter = Duration::zero();
+    ++cycles_;
+    totalJitter_ += jitter;
+    maxJitter_ = std::max(maxJitter_, jitter);
+    lastJitter_ = jitter;
+}
+
+void CycleStats::recordEnd(cycle::Clock::time_point end, cycle::Clock::time_point nextDeadline) {
+    if (end > nextDeadline) {
+        ++overruns_;
+    }
+}
+
+uint64_t CycleStats::cycles() const {
+    return cycles_;
+}
+
+uint64_t CycleStats::overruns() const {
+    return overruns_;
+}
+
+CycleStats::Duration CycleStats::meanJitter() const {
+    return cycles_ == 0 ? Duration::zero() : Duration(totalJitter_.count() / static_cast<Duration::rep>(cycles_));
+}
+
+CycleStats::Duration CycleStats::maxJitter() const {
+    return maxJitter_;
+}
+
+CycleStats::Duration CycleStats::lastJitter() const {
+    return lastJitter_;
+}
@@ -1,11 +1,21 @@
 #include "data_storage.h"
 #include "config.h"
+#include "sqlite_partitions.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <cstdlib>
 #include <ctime>
+#include <cmath>
+#include <iterator>
+#include <algorithm>
 #include <iomanip>
 #include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <unordered_map>
 
 #ifdef ENABLE_INFLUXDB
     #include <curl/curl.h>
@@ -15,105 +25,564 @@
 
 namespace {
 
-std::string timePointToString(const std::chrono::system_clock::time_point& tp) {
-    auto time = std::chrono::system_clock::to_time_t(tp);
-    std::tm* tm_info = std::localtime(&time);
-    std::ostringstream oss;
-    oss << std::put_time(tm_info, "%Y-%m-%d %H:%M:%S");
-    return oss.str();
+constexpr int kSQLiteBusyTimeoutMs = 5000;
+constexpr int kDefaultCheckpointPages = 1000;
+constexpr std::chrono::hours kRetentionInterval(1);
+constexpr double kDefaultResolution = 0.001;
+
+const char* const kLegacySchema[] = {
+    "CREATE TABLE IF NOT EXISTS sensor_data ("
+    "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+    "sensor_name TEXT NOT NULL, "
+    "slave_id INTEGER NOT NULL, "
+    "temperature REAL NOT NULL, "
+    "humidity REAL NOT NULL, "
+    "timestamp INTEGER NOT NULL)",
+    "CREATE INDEX IF NOT EXISTS idx_timestamp ON sensor_data(timestamp)",
+};
+
+const char* const kCompactSchema[] = {
+    "CREATE TABLE IF NOT EXISTS sensors ("
+    "sensor_id INTEGER PRIMARY KEY, "
+    "name TEXT NOT NULL UNIQUE, "
+    "slave_id INTEGER NOT NULL, "
+    "temp_scale REAL NOT NULL, "
+    "humi_scale REAL NOT NULL)",
+    "CREATE TABLE IF NOT EXISTS readings ("
+    "sensor_id INTEGER NOT NULL, "
+    "timestamp_ms INTEGER NOT NULL, "
+    "temperature INTEGER NOT NULL, "
+    "humidity INTEGER NOT NULL, "
+    "PRIMARY KEY (sensor_id, timestamp_ms)) WITHOUT ROWID",
+    "CREATE VIEW IF NOT EXISTS sensor_readings AS SELECT "
+    "s.name AS sensor_name, s.slave_id AS slave_id, "
+    "r.temperature * s.temp_scale AS temperature, r.humidity * s.humi_scale AS humidity, "
+    "r.timestamp_ms / 1000 AS timestamp, r.timestamp_ms AS timestamp_ms "
+    "FROM readings r JOIN sensors s ON s.sensor_id = r.sensor_id",
+};
+
+struct Rollup {
+    const char* table;
+    const char* view;
+    long long seconds;
+};
+
+constexpr Rollup kRollups[] = {
+    {"rollup_1m", "sensor_rollup_1m", 60},
+    {"rollup_1h", "sensor_rollup_1h", 3600},
+};
+
+const char* rollupKey(bool compact) {
+    return compact ? "sensor_id" : "sensor_name";
+}
+
+std::string rollupSchema(const Rollup& rollup, bool compact) {
+    return std::string("CREATE TABLE IF NOT EXISTS ") + rollup.table + " (" +
+           rollupKey(compact) + (compact ? " INTEGER NOT NULL, " : " TEXT NOT NULL, ") +
+           "bucket INTEGER NOT NULL, "
+           "count INTEGER NOT NULL, "
+           "temp_min REAL NOT NULL, "
+           "temp_max REAL NOT NULL, "
+           "temp_sum REAL NOT NULL, "
+           "humi_min REAL NOT NULL, "
+           "humi_max REAL NOT NULL, "
+           "humi_sum REAL NOT NULL, "
+           "PRIMARY KEY (" + rollupKey(compact) + ", bucket)) WITHOUT ROWID";
+}
+
+std::string rollupView(const Rollup& rollup) {
+    return std::string("CREATE VIEW IF NOT EXISTS ") + rollup.view + " AS SELECT "
+           "s.name AS sensor_name, r.bucket AS bucket, r.count AS count, "
+           "r.temp_min AS temp_min, r.temp_max AS temp_max, r.temp_sum AS temp_sum, "
+           "r.humi_min AS humi_min, r.humi_max AS humi_max, r.humi_sum AS humi_sum "
+           "FROM " + rollup.table + " r JOIN sensors s ON s.sensor_id = r.sensor_id";
+}
+
+std::string rollupUpsert(const Rollup& rollup, bool compact) {
+    return std::string("INSERT INTO ") + rollup.table + " (" + rollupKey(compact) +
+           ", bucket, count, temp_min, temp_max, temp_sum, humi_min, humi_max, humi_sum) "
+           "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?) "
+           "ON CONFLICT (" + rollupKey(compact) + ", bucket) DO UPDATE SET "
+           "count = count + excluded.count, "
+           "temp_min = min(temp_min, excluded.temp_min), "
+           "temp_max = max(temp_max, excluded.temp_max), "
+           "temp_sum = temp_sum + excluded.temp_sum, "
+           "humi_min = min(humi_min, excluded.humi_min), "
+           "humi_max = max(humi_max, excluded.humi_max), "
+           "humi_sum = humi_sum + excluded.humi_sum";
+}
+
+double storageResolution(const PointFormat& format, double scale) {
+    if (format.type == DataType::Float32 || scale <= 0.0) return kDefaultResolution;
+    return scale;
 }
 
 class SQLiteStorage : public DataStorage {
 public:
-    SQLiteStorage(const std::string& dbPath) : dbPath_(dbPath), db_(nullptr) {}
+    SQLiteStorage(const StorageConfig& config, const std::vector<SensorConfig>& sensors)
+        : config_(config), sensors_(sensors), partitions_(config.sqlite_path, config.sqlite_partition),
+          expiredBefore_(SQLitePartitions::TimePoint::min()), db_(nullptr), insert_(nullptr), findSensor_(nullptr), addSensor_(nullptr),
+          rollups_(), begin_(nullptr), commit_(nullptr), rollback_(nullptr),
+          checkpointPages_(config.sqlite_checkpoint_pages > 0 ? config.sqlite_checkpoint_pages
+                                                              : kDefaultCheckpointPages),
+          checkpointDue_(false), checkpointStopping_(false), duplicates_(0) {
+        resetKeys();
+    }
 
     ~SQLiteStorage() override {
         close();
     }
 
     bool save(const SensorRecord& record) override {
-        if (!db_) return false;
-
-        std::string sql = "INSERT INTO sensor_data (sensor_name, slave_id, temperature, humidity, timestamp) "
-                         "VALUES ('" + escapeString(record.sensor_name) + "', " +
-                         std::to_string(record.slave_id) + ", " +
-                         std::to_string(record.temperature) + ", " +
-                         std::to_string(record.humidity) + ", " +
-                         std::to_string(std::chrono::system_clock::to_time_t(record.timestamp)) + ")";
-
-        char* errMsg = nullptr;
-        int result = sqlite3_exec(db_, sql.c_str(), nullptr, nullptr, &errMsg);
-        if (result != SQLITE_OK) {
-            std::cerr << "SQLite插入失败: " << errMsg << std::endl;
-            sqlite3_free(errMsg);
-            return false;
-        }
-        return true;
+        return saveBatch(std::vector<SensorRecord>{record});
     }
 
     bool saveBatch(const std::vector<SensorRecord>& records) override {
-        if (!db_ || records.empty()) return false;
+        if (records.empty()) return true;
 
-        bool success = true;
-        for (const auto& record : records) {
-            if (!save(record)) {
-                success = false;
+        dropExpired();
+        size_t begin = 0;
+        size_t expired = 0;
+        while (begin < records.size()) {
+            if (records[begin].timestamp < expiredBefore_) {
+                ++expired;
+                ++begin;
+                continue;
+            }
+            if (!usePartition(records[begin].timestamp)) return false;
+            size_t end = begin + 1;
+            while (end < records.size() && records[end].timestamp >= current_.start &&
+                   records[end].timestamp < current_.end && records[end].timestamp >= expiredBefore_) {
+                ++end;
             }
+            if (!saveRange(records, begin, end)) return false;
+            begin = end;
         }
-        return success;
+        if (expired > 0) {
+            std::cerr << "忽略 " << expired << " 条早于数据保留期限的记录" << std::endl;
+        }
+        return true;
     }
 
     void close() override {
+        if (checkpointer_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(checkpointMutex_);
+                checkpointStopping_ = true;
+            }
+            checkpointReady_.notify_one();
+            checkpointer_.join();
+            checkpointDue_ = false;
+            checkpointStopping_ = false;
+        }
+        for (sqlite3_stmt** stmt : {&insert_, &findSensor_, &addSensor_, &begin_, &commit_, &rollback_}) {
+            sqlite3_finalize(*stmt);
+            *stmt = nullptr;
+        }
+        for (sqlite3_stmt*& stmt : rollups_) {
+            sqlite3_finalize(stmt);
+            stmt = nullptr;
+        }
         if (db_) {
             sqlite3_close(db_);
             db_ = nullptr;
         }
+        resetKeys();
+    }
+
+    uint64_t duplicates() const override {
+        return duplicates_.load(std::memory_order_relaxed);
     }
 
     bool initialize() {
-        int result = sqlite3_open(dbPath_.c_str(), &db_);
-        if (result != SQLITE_OK) {
-            std::cerr << "无法打开SQLite数据库: " << sqlite3_errmsg(db_) << std::endl;
+        if (!usePartition(std::chrono::system_clock::now())) return false;
+        dropExpired();
+        return true;
+    }
+
+private:
+    struct SensorKey {
+        std::string name;
+        sqlite3_int64 id = 0;
+        double tempScale = kDefaultResolution;
+        double humiScale = kDefaultResolution;
+    };
+
+    struct RollupBucket {
+        const std::string* name;
+        sqlite3_int64 sensorId;
+        long long bucket;
+        long long count;
+        double tempMin;
+        double tempMax;
+        double tempSum;
+        double humiMin;
+        double humiMax;
+        double humiSum;
+    };
+
+    bool usePartition(std::chrono::system_clock::time_point time) {
+        if (!db_ || time < current_.start || time >= current_.end) {
+            close();
+            current_ = partitions_.at(time);
+            if (!open(current_.path)) return false;
+        }
+        return true;
+    }
+
+    void dropExpired() {
+        if (config_.sqlite_retention_days <= 0) return;
+        auto now = std::chrono::steady_clock::now();
+        if (now < nextRetention_) return;
+        nextRetention_ = now + kRetentionInterval;
+
+        auto cutoff = std::chrono::system_clock::now() - std::chrono::hours(24) * config_.sqlite_retention_days;
+        expiredBefore_ = partitions_.at(cutoff).start;
+        size_t dropped = partitions_.dropBefore(cutoff, current_.path);
+        if (dropped > 0) {
+            std::cout << "已删除 " << dropped << " 个过期的SQLite分区" << std::endl;
+        }
+    }
+
+    bool saveRange(const std::vector<SensorRecord>& records, size_t begin, size_t end) {
+        if (!execute(begin_)) {
+            std::cerr << "SQLite开始事务失败: " << sqlite3_errmsg(db_) << std::endl;
+            return false;
+        }
+
+        inserted_.assign(end - begin, false);
+        sensorIds_.clear();
+        uint64_t duplicates = 0;
+        for (size_t i = begin; i < end; ++i) {
+            if (!insert(records[i])) {
+                execute(rollback_);
+                resetKeys();
+                return false;
+            }
+            inserted_[i - begin] = sqlite3_changes(db_) > 0;
+            duplicates += inserted_[i - begin] ? 0 : 1;
+        }
+
+        if (config_.sqlite_rollups && !updateRollups(records, begin, end)) {
+            execute(rollback_);
+            resetKeys();
             return false;
         }
 
-        const char* createTableSQL =
-            "CREATE TABLE IF NOT EXISTS sensor_data ("
-            "id INTEGER PRIMARY KEY AUTOINCREMENT, "
-            "sensor_name TEXT NOT NULL, "
-            "slave_id INTEGER NOT NULL, "
-            "temperature REAL NOT NULL, "
-            "humidity REAL NOT NULL, "
-            "timestamp INTEGER NOT NULL)";
+        if (!execute(commit_)) {
+            std::cerr << "SQLite提交事务失败: " << sqlite3_errmsg(db_) << std::endl;
+            execute(rollback_);
+            resetKeys();
+            return false;
+        }
+        duplicates_.fetch_add(duplicates, std::memory_order_relaxed);
+        return true;
+    }
+
+    void resetKeys() {
+        keys_.assign(sensors_.size(), SensorKey());
+        extraKeys_.clear();
+    }
 
-        char* errMsg = nullptr;
-        result = sqlite3_exec(db_, createTableSQL, nullptr, nullptr, &errMsg);
+    bool open(const std::string& path) {
+        int result = sqlite3_open(path.c_str(), &db_);
         if (result != SQLITE_OK) {
-            std::cerr << "创建表失败: " << errMsg << std::endl;
-            sqlite3_free(errMsg);
+            std::cerr << "无法打开SQLite数据库: " << sqlite3_errmsg(db_) << std::endl;
             sqlite3_close(db_);
             db_ = nullptr;
             return false;
         }
+        sqlite3_busy_timeout(db_, kSQLiteBusyTimeoutMs);
+
+        if (config_.sqlite_page_size > 0) {
+            pragma("page_size", std::to_string(config_.sqlite_page_size));
+        }
+        std::string journalMode = pragma("journal_mode", config_.sqlite_journal_mode);
+        if (!config_.sqlite_synchronous.empty()) {
+            pragma("synchronous", config_.sqlite_synchronous);
+        }
+        if (config_.sqlite_cache_kb > 0) {
+            pragma("cache_size", std::to_string(-config_.sqlite_cache_kb));
+        }
+        if (config_.sqlite_mmap_mb > 0) {
+            pragma("mmap_size", std::to_string(static_cast<long long>(config_.sqlite_mmap_mb) * 1024 * 1024));
+        }
+        if (!config_.sqlite_journal_mode.empty() && journalMode != config_.sqlite_journal_mode) {
+            std::cerr << "SQLite journal_mode 设置为 " << config_.sqlite_journal_mode << " 失败, 当前为 "
+                      << journalMode << std::endl;
+        }
+
+        bool compact = config_.sqlite_schema == SQLiteSchema::Compact;
+        const char* const* schema = compact ? kCompactSchema : kLegacySchema;
+        size_t schemaSize = compact ? std::size(kCompactSchema) : std::size(kLegacySchema);
+        for (size_t i = 0; i < schemaSize; ++i) {
+            char* errMsg = nullptr;
+            result = sqlite3_exec(db_, schema[i], nullptr, nullptr, &errMsg);
+            if (result != SQLITE_OK) {
+                std::cerr << "创建表失败: " << errMsg << std::endl;
+                sqlite3_free(errMsg);
+                sqlite3_close(db_);
+                db_ = nullptr;
+                return false;
+            }
+        }
+
+        bool prepared = compact
+            ? prepare("INSERT INTO readings (sensor_id, timestamp_ms, temperature, humidity) "
+                      "VALUES (?, ?, ?, ?) ON CONFLICT (sensor_id, timestamp_ms) DO NOTHING", &insert_) &&
+              prepare("SELECT sensor_id, temp_scale, humi_scale FROM sensors WHERE name = ?", &findSensor_) &&
+              prepare("INSERT INTO sensors (name, slave_id, temp_scale, humi_scale) VALUES (?, ?, ?, ?)", &addSensor_)
+            : prepare("INSERT INTO sensor_data (sensor_name, slave_id, temperature, humidity, timestamp) "
+                      "VALUES (?, ?, ?, ?, ?)", &insert_);
+        for (size_t i = 0; prepared && config_.sqlite_rollups && i < std::size(kRollups); ++i) {
+            prepared = sqlite3_exec(db_, rollupSchema(kRollups[i], compact).c_str(), nullptr, nullptr, nullptr) == SQLITE_OK &&
+                       (!compact || sqlite3_exec(db_, rollupView(kRollups[i]).c_str(), nullptr, nullptr, nullptr) == SQLITE_OK) &&
+                       prepare(rollupUpsert(kRollups[i], compact).c_str(), &rollups_[i]);
+        }
+        if (!prepared || !prepare("BEGIN", &begin_) || !prepare("COMMIT", &commit_) ||
+            !prepare("ROLLBACK", &rollback_)) {
+            close();
+            return false;
+        }
 
-        const char* createIndexSQL = "CREATE INDEX IF NOT EXISTS idx_timestamp ON sensor_data(timestamp)";
-        sqlite3_exec(db_, createIndexSQL, nullptr, nullptr, nullptr);
+        if (journalMode == "wal") {
+            pragma("wal_autocheckpoint", "0");
+            long long pageSize = std::atoll(pragma("page_size", "").c_str());
+            if (pageSize > 0) {
+                pragma("journal_size_limit", std::to_string(checkpointPages_ * pageSize));
+            }
+            sqlite3_wal_hook(db_, &SQLiteStorage::onWalCommit, this);
+            checkpointer_ = std::thread([this, path] { runCheckpoints(path); });
+        }
 
         return true;
     }
 
-private:
-    std::string escapeString(const std::string& str) {
-        std::string result;
-        for (char c : str) {
-            if (c == '\'') result += "''";
-            else result += c;
+    std::string pragma(const std::string& name, const std::string& value) {
+        std::string sql = "PRAGMA " + name + (value.empty() ? "" : "=" + value);
+        sqlite3_stmt* stmt = nullptr;
+        std::string current;
+        if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+            if (sqlite3_step(stmt) == SQLITE_ROW && sqlite3_column_text(stmt, 0)) {
+                current = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+            }
+        } else {
+            std::cerr << "SQLite设置 " << name << " 失败: " << sqlite3_errmsg(db_) << std::endl;
         }
-        return result;
+        sqlite3_finalize(stmt);
+        return current;
     }
 
-    std::string dbPath_;
+    static int onWalCommit(void* self, sqlite3*, const char*, int pages) {
+        auto* storage = static_cast<SQLiteStorage*>(self);
+        if (pages >= storage->checkpointPages_) {
+            {
+                std::lock_guard<std::mutex> lock(storage->checkpointMutex_);
+                storage->checkpointDue_ = true;
+            }
+            storage->checkpointReady_.notify_one();
+        }
+        return SQLITE_OK;
+    }
+
+    void runCheckpoints(const std::string& path) {
+        sqlite3* db = nullptr;
+        if (sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READWRITE, nullptr) != SQLITE_OK) {
+            std::cerr << "SQLite检查点线程无法打开数据库: " << sqlite3_errmsg(db) << std::endl;
+            sqlite3_close(db);
+            return;
+        }
+        sqlite3_busy_timeout(db, kSQLiteBusyTimeoutMs);
+        sqlite3_exec(db, "PRAGMA journal_mode", nullptr, nullptr, nullptr);
+
+        std::unique_lock<std::mutex> lock(checkpointMutex_);
+        while (true) {
+            checkpointReady_.wait(lock, [this] { return checkpointDue_ || checkpointStopping_; });
+            if (checkpointStopping_) break;
+            checkpointDue_ = false;
+            lock.unlock();
+
+            if (sqlite3_wal_checkpoint_v2(db, nullptr, SQLITE_CHECKPOINT_PASSIVE, nullptr, nullptr) != SQLITE_OK) {
+                std::cerr << "SQLite检查点失败: " << sqlite3_errmsg(db) << std::endl;
+            }
+
+            lock.lock();
+        }
+        lock.unlock();
+        sqlite3_close(db);
+    }
+
+    bool prepare(const char* sql, sqlite3_stmt** stmt) {
+        if (sqlite3_prepare_v2(db_, sql, -1, stmt, nullptr) != SQLITE_OK) {
+            std::cerr << "SQLite预编译语句失败: " << sqlite3_errmsg(db_) << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool execute(sqlite3_stmt* stmt) {
+        int result = sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+        return result == SQLITE_DONE;
+    }
+
+    bool insert(const SensorRecord& record) {
+        if (config_.sqlite_schema == SQLiteSchema::Compact) {
+            return insertCompact(record);
+        }
+
+        sqlite3_bind_text(insert_, 1, record.sensor_name.data(), static_cast<int>(record.sensor_name.size()),
+                          SQLITE_STATIC);
+        sqlite3_bind_int(insert_, 2, record.slave_id);
+        sqlite3_bind_double(insert_, 3, record.temperature);
+        sqlite3_bind_double(insert_, 4, record.humidity);
+        sqlite3_bind_int64(insert_, 5, static_cast<sqlite3_int64>(std::chrono::system_clock::to_time_t(record.timestamp)));
+
+        bool ok = execute(insert_);
+        sqlite3_clear_bindings(insert_);
+        if (!ok) {
+            std::cerr << "SQLite插入失败: " << sqlite3_errmsg(db_) << std::endl;
+        }
+        return ok;
+    }
+
+    bool updateRollups(const std::vector<SensorRecord>& records, size_t begin, size_t end) {
+        bool compact = config_.sqlite_schema == SQLiteSchema::Compact;
+        for (size_t r = 0; r < std::size(kRollups); ++r) {
+            long long seconds = kRollups[r].seconds;
+            buckets_.clear();
+
+            for (size_t i = begin; i < end; ++i) {
+                if (!inserted_[i - begin]) continue;
+                const SensorRecord& record = records[i];
+                sqlite3_int64 sensorId = compact ? sensorIds_[i - begin] : 0;
+                long long time = std::chrono::duration_cast<std::chrono::seconds>(record.timestamp.time_since_epoch()).count();
+                long long bucket = time - ((time % seconds) + seconds) % seconds;
+
+                auto it = std::find_if(buckets_.rbegin(), buckets_.rend(), [&](const RollupBucket& b) {
+                    return b.bucket == bucket && (compact ? b.sensorId == sensorId : *b.name == record.sensor_name);
+                });
+                if (it == buckets_.rend()) {
+                    buckets_.push_back({&record.sensor_name, sensorId, bucket, 1, record.temperature, record.temperature,
+                                        record.temperature, record.humidity, record.humidity, record.humidity});
+                    continue;
+                }
+                ++it->count;
+                it->tempMin = std::min(it->tempMin, record.temperature);
+                it->tempMax = std::max(it->tempMax, record.temperature);
+                it->tempSum += record.temperature;
+                it->humiMin = std::min(it->humiMin, record.humidity);
+                it->humiMax = std::max(it->humiMax, record.humidity);
+                it->humiSum += record.humidity;
+            }
+
+            sqlite3_stmt* upsert = rollups_[r];
+            for (const auto& bucket : buckets_) {
+                if (compact) {
+                    sqlite3_bind_int64(upsert, 1, bucket.sensorId);
+                } else {
+                    sqlite3_bind_text(upsert, 1, bucket.name->data(), static_cast<int>(bucket.name->size()),
+                                      SQLITE_STATIC);
+                }
+                sqlite3_bind_int64(upsert, 2, bucket.bucket);
+                sqlite3_bind_int64(upsert, 3, bucket.count);
+                sqlite3_bind_double(upsert, 4, bucket.tempMin);
+                sqlite3_bind_double(upsert, 5, bucket.tempMax);
+                sqlite3_bind_double(upsert, 6, bucket.tempSum);
+                sqlite3_bind_double(upsert, 7, bucket.humiMin);
+                sqlite3_bind_double(upsert, 8, bucket.humiMax);
+                sqlite3_bind_double(upsert, 9, bucket.humiSum);
+                if (!execute(upsert)) {
+                    std::cerr << "SQLite更新汇总表失败: " << sqlite3_errmsg(db_) << std::endl;
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool insertCompact(const SensorRecord& record) {
+        SensorKey& key = record.sensor_id < keys_.size() ? keys_[record.sensor_id] : extraKeys_[record.sensor_name];
+        if (key.name != record.sensor_name && !resolveSensor(record, key)) {
+            return false;
+        }
+
+        auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(record.timestamp.time_since_epoch());
+        sqlite3_bind_int64(insert_, 1, key.id);
+        sqlite3_bind_int64(insert_, 2, static_cast<sqlite3_int64>(timestamp.count()));
+        sqlite3_bind_int64(insert_, 3, static_cast<sqlite3_int64>(std::llround(record.temperature / key.tempScale)));
+        sqlite3_bind_int64(insert_, 4, static_cast<sqlite3_int64>(std::llround(record.humidity / key.humiScale)));
+
+        if (!execute(insert_)) {
+            std::cerr << "SQLite插入失败: " << sqlite3_errmsg(db_) << std::endl;
+            return false;
+        }
+        sensorIds_.push_back(key.id);
+        return true;
+    }
+
+    bool resolveSensor(const SensorRecord& record, SensorKey& key) {
+        const std::string& name = record.sensor_name;
+        sqlite3_bind_text(findSensor_, 1, name.data(), static_cast<int>(name.size()), SQLITE_STATIC);
+        if (sqlite3_step(findSensor_) == SQLITE_ROW) {
+            key.id = sqlite3_column_int64(findSensor_, 0);
+            key.tempScale = sqlite3_column_double(findSensor_, 1);
+            key.humiScale = sqlite3_column_double(findSensor_, 2);
+            sqlite3_reset(findSensor_);
+            key.name = name;
+            return true;
+        }
+        sqlite3_reset(findSensor_);
+
+        key.tempScale = kDefaultResolution;
+        key.humiScale = kDefaultResolution;
+        for (const auto& sensor : sensors_) {
+            if (sensor.name == name) {
+                key.tempScale = storageResolution(sensor.temp_format, sensor.temp_scale);
+                key.humiScale = storageResolution(sensor.humi_format, sensor.humi_scale);
+                break;
+            }
+        }
+
+        sqlite3_bind_text(addSensor_, 1, name.data(), static_cast<int>(name.size()), SQLITE_STATIC);
+        sqlite3_bind_int(addSensor_, 2, record.slave_id);
+        sqlite3_bind_double(addSensor_, 3, key.tempScale);
+        sqlite3_bind_double(addSensor_, 4, key.humiScale);
+        if (!execute(addSensor_)) {
+            std::cerr << "SQLite添加传感器失败: " << sqlite3_errmsg(db_) << std::endl;
+            return false;
+        }
+        key.id = sqlite3_last_insert_rowid(db_);
+        key.name = name;
+        return true;
+    }
+
+    StorageConfig config_;
+    std::vector<SensorConfig> sensors_;
+    SQLitePartitions partitions_;
+    SQLitePartitions::Partition current_;
+    std::chrono::steady_clock::time_point nextRetention_;
+    SQLitePartitions::TimePoint expiredBefore_;
+    std::vector<SensorKey> keys_;
+    std::unordered_map<std::string, SensorKey> extraKeys_;
+    std::vector<RollupBucket> buckets_;
+    std::vector<bool> inserted_;
+    std::vector<sqlite3_int64> sensorIds_;
     sqlite3* db_;
+    sqlite3_stmt* insert_;
+    sqlite3_stmt* findSensor_;
+    sqlite3_stmt* addSensor_;
+    sqlite3_stmt* rollups_[std::size(kRollups)];
+    sqlite3_stmt* begin_;
+    sqlite3_stmt* commit_;
+    sqlite3_stmt* rollback_;
+    std::thread checkpointer_;
+    std::mutex checkpointMutex_;
+    std::condition_variable checkpointReady_;
+    int checkpointPages_;
+    bool checkpointDue_;
+    bool checkpointStopping_;
+    std::atomic<uint64_t> duplicates_;
 };
 
 class CSVStorage : public DataStorage {
@@ -266,10 +735,11 @@ private:
 
 } // namespace
 
-std::unique_ptr<DataStorage> StorageFactory::create(StorageType type, const StorageConfig& config) {
+std::unique_ptr<DataStorage> StorageFactory::create(StorageType type, const StorageConfig& config,
+                                                   const std::vector<SensorConfig>& sensors) {
     switch (type) {
         case StorageType::SQLite: {
-            auto storage = std::make_unique<SQLiteStorage>(config.sqlite_path);
+            auto storage = std::make_unique<SQLiteStorage>(config, sensors);
             if (storage->initialize()) {
                 return storage;
             }
@@ -304,3 +774,38 @@ std::string StorageFactory::storageTypeToString(StorageType type) {
         default: return "Unknown";
     }
 }
+
+std::vector<SensorRecord> convertToRecords(const std::vector<SensorData>& data,
+                                           const std::vector<std::string>& names) {
+    std::vector<SensorRecord> records;
+    records.reserve(data.size());
+    convertToRecords(data, names, records);
+    return records;
+}
+
+void convertToRecords(const std::vector<SensorData>& data, const std::vector<std::string>& names,
+                      std::vector<SensorRecord>& records) {
+    auto now = std::chrono::system_clock::now();
+    size_t count = 0;
+
+    for (const auto& sensor : data) {
+        if (sensor.error || sensor.sensor_id >= names.size()) {
+            continue;
+        }
+        if (count == records.size()) {
+            records.emplace_back();
+        }
+        SensorRecord& record = records[count++];
+        const std::string& name = names[sensor.sensor_id];
+        if (record.sensor_name != name) {
+            record.sensor_name = name;
+        }
+        record.sensor_id = sensor.sensor_id;
+        record.slave_id = sensor.slave_id;
+        record.temperature = sensor.temperature;
+        record.humidity = sensor.humidity;
+        record.timestamp = now;
+    }
+
+    records.resize(count);
+}
@@ -5,22 +5,25 @@
 #include <atomic>
 #include <memory>
 #include <iomanip>
-#include <sstream>
+#include <ctime>
 
 #include "config.h"
 #include "sensor_reader.h"
 #include "data_storage.h"
+#include "storage_writer.h"
+
+#include "poll_scheduler.h"
+#include "cycle_timer.h"
 
 #ifdef _WIN32
     #include <windows.h>
-    #define SLEEP_MS(ms) Sleep(ms)
-#else
-    #include <unistd.h>
-    #define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 std::atomic<bool> keepRunning(true);
 
+const std::chrono::milliseconds kMaxIdleWait(200);
+const std::chrono::seconds kStatsInterval(60);
+
 #ifdef _WIN32
 BOOL WINAPI consoleHandler(DWORD ctrlType) {
     if (ctrlType == CTRL_C_EVENT) {
@@ -36,20 +39,28 @@ void signalHandler(int sig) {
 }
 #endif
 
-void printSensorData(const std::vector<SensorData>& data) {
+void printSensorData(const PollPlan& plan, const std::vector<SensorData>& data) {
     auto now = std::chrono::system_clock::now();
     auto time_t_now = std::chrono::system_clock::to_time_t(now);
-    std::tm* tm_info = std::localtime(&time_t_now);
+    std::tm tm_info{};
+#ifdef _WIN32
+    localtime_s(&tm_info, &time_t_now);
+#else
+    localtime_r(&time_t_now, &tm_info);
+#endif
 
-    std::ostringstream oss;
-    oss << std::put_time(tm_info, "%Y-%m-%d %H:%M:%S");
-    std::cout << "[" << oss.str() << "]" << std::endl;
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &tm_info);
+    std::cout << "[" << timestamp << "]" << std::endl;
 
     for (const auto& sensor : data) {
-        if (sensor.error) {
-            std::cout << "  " << sensor.name << ": 读取失败 - " << sensor.error_message << std::endl;
+        const std::string& name = plan.names[sensor.sensor_id];
+        if (sensor.offline) {
+            std::cout << "  " << name << ": 离线" << std::endl;
+        } else if (sensor.error) {
+            std::cout << "  " << name << ": 读取失败 - " << readErrorMessage(sensor.error_code) << std::endl;
         } else {
-            std::cout << "  " << sensor.name << ": "
+            std::cout << "  " << name << ": "
                       << "温度=" << std::fixed << std::setprecision(1) << sensor.temperature << "°C, "
                       << "湿度=" << sensor.humidity << "%" << std::endl;
         }
@@ -57,30 +68,20 @@ void printSensorData(const std::vector<SensorData>& data) {
     std::cout << std::endl;
 }
 
-std::vector<SensorRecord> convertToRecords(const std::vector<SensorData>& data,
-                                           const std::vector<SensorConfig>& configs) {
-    std::vector<SensorRecord> records;
-    records.reserve(data.size());
-
-    auto now = std::chrono::system_clock::now();
-
-    for (size_t i = 0; i < data.size(); ++i) {
-        if (!data[i].error) {
-            SensorRecord record;
-            record.sensor_name = data[i].name;
-            record.slave_id = data[i].slave_id;
-            record.temperature = data[i].temperature;
-            record.humidity = data[i].humidity;
-            record.timestamp = now;
-            records.push_back(record);
-        }
-    }
-
-    return records;
+void printCycleStats(const CycleStats& stats) {
+    std::cout << "共 " << stats.cycles() << " 个周期, 启动抖动 平均 "
+              << stats.meanJitter().count() << "us / 最大 " << stats.maxJitter().count()
+              << "us, 超时周期 " << stats.overruns() << " 个" << std::endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     std::string configFilename = "config.json";
+    bool printPlan = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--print-plan") {
+            printPlan = true;
+        }
+    }
 
     std::cout << "Modbus温湿度传感器读取程序 (C++)" << std::endl;
     std::cout << "==============================" << std::endl;
@@ -92,7 +93,7 @@ int main() {
     AppConfig config = Config::exists(configFilename) ?
                       Config::load(configFilename) : Config::loadDefault();
 
-    config.print();
+    Config::print(config);
 
 #ifdef _WIN32
     if (!SetConsoleCtrlHandler(consoleHandler, TRUE)) {
@@ -106,21 +107,57 @@ int main() {
     std::cout << std::endl;
     std::cout << "正在初始化Modbus连接..." << std::endl;
 
-    SensorReader reader(
-        config.modbus.port,
-        config.modbus.baudrate,
-        config.modbus.data_bits,
-        config.modbus.stop_bits,
-        config.modbus.parity,
-        static_cast<int>(config.getTimeout().count())
-    );
+    MultiPortReader reader;
+    reader.setPollMode(config.modbus.poll_mode);
+    reader.setPlannerOptions({static_cast<uint16_t>(config.modbus.coalesce_max_gap),
+                              static_cast<uint16_t>(config.modbus.coalesce_max_registers)});
+    reader.setBreakerOptions({config.modbus.offline_failures,
+                              std::chrono::milliseconds(static_cast<long long>(config.modbus.offline_retry * 1000)),
+                              std::chrono::milliseconds(static_cast<long long>(config.modbus.offline_retry_max * 1000))});
+    RealtimeOptions realtime{config.modbus.realtime_priority, config.modbus.cpu_affinity};
+    if (realtime.priority > 0 || !realtime.cpus.empty()) {
+        if (!cycle::applyRealtime(realtime)) {
+            std::cerr << "警告: 无法设置实时调度或CPU亲和性 (需要CAP_SYS_NICE权限)" << std::endl;
+        }
+        if (realtime.priority > 0 && !cycle::lockMemory()) {
+            std::cerr << "警告: 无法锁定内存 (mlockall)" << std::endl;
+        }
+        reader.setRealtimeOptions(realtime);
+    }
+    for (const auto& port : config.modbus.ports) {
+        int timeoutMs = static_cast<int>(Config::getTimeout(port).count());
+        bool added = port.transport == TransportType::TCP ?
+            reader.addTcpPort(port.name, port.host, port.tcp_port, timeoutMs, port.max_in_flight) :
+            reader.addPort(port.name, port.port, port.baudrate, port.data_bits,
+                           port.stop_bits, port.parity, timeoutMs);
+        if (!added) {
+            std::cerr << "警告: 串口数量超过上限，忽略 " << port.name << std::endl;
+            continue;
+        }
+        reader.setTimeoutBounds(port.name, Config::getMinTimeout(port), Config::getMaxTimeout(port));
+        reader.setSerialOptions(port.name, {port.rs485, port.low_latency,
+                                            port.rs485_delay_before_send, port.rs485_delay_after_send});
+    }
 
-    if (!reader.connect()) {
-        std::cerr << "错误: 无法连接到设备 " << config.modbus.port << std::endl;
+    for (const auto& sensor : config.modbus.sensors) {
+        if (sensor.inter_frame_gap_ms > 0.0) {
+            reader.setSlaveGap(sensor.port_name, sensor.slave_id,
+                               std::chrono::microseconds(static_cast<long long>(sensor.inter_frame_gap_ms * 1000)));
+        }
+    }
+
+    PollPlan plan = reader.compilePlan(config.modbus.sensors);
+    if (printPlan) {
+        std::cout << std::endl;
+        plan.print(std::cout);
+        return 0;
+    }
+
+    if (!reader.connectAll()) {
+        std::cerr << "错误: 无法连接到任何串口设备" << std::endl;
         return 1;
     }
 
-    std::cout << "成功连接到设备 " << config.modbus.port << std::endl;
     std::cout << "已配置 " << config.modbus.sensors.size() << " 个传感器" << std::endl;
     std::cout << "开始读取温湿度数据..." << std::endl;
     std::cout << "按 Ctrl+C 退出程序" << std::endl;
@@ -128,44 +165,97 @@ int main() {
 
     std::unique_ptr<DataStorage> storage = StorageFactory::create(
         config.storage.type,
-        config.storage
+        config.storage,
+        config.modbus.sensors
     );
 
+    std::unique_ptr<StorageWriter> writer;
     if (storage) {
         std::cout << "数据存储已启用: " << StorageFactory::storageTypeToString(config.storage.type) << std::endl;
+        writer = std::make_unique<StorageWriter>(std::move(storage), config.storage);
     } else {
         std::cout << "数据存储已禁用" << std::endl;
     }
 
-    std::vector<std::tuple<uint8_t, uint16_t, uint16_t, double, double, std::string>> sensorParams;
-    for (const auto& sensor : config.modbus.sensors) {
-        sensorParams.push_back(std::make_tuple(
-            sensor.slave_id,
-            sensor.temp_reg,
-            sensor.humi_reg,
-            sensor.temp_scale,
-            sensor.humi_scale,
-            sensor.name
-        ));
-    }
+    PollScheduler scheduler(plan.periods, PollScheduler::Clock::now());
+    std::vector<uint64_t> reportedMisses(plan.size(), 0);
+    std::vector<size_t> dueIndices;
+    std::vector<SensorData> results;
+    std::vector<SensorRecord> records;
+    uint64_t reportedDrops = 0;
+    uint64_t reportedSpills = 0;
+
+    CycleStats cycleStats;
+    auto nextStats = PollScheduler::Clock::now() + kStatsInterval;
 
     while (keepRunning) {
-        std::vector<SensorData> results = reader.readAllSensors(sensorParams);
-        printSensorData(results);
+        auto deadline = scheduler.nextDeadline();
+        auto now = PollScheduler::Clock::now();
+        if (deadline > now) {
+            cycle::sleepUntil(std::min(deadline, now + kMaxIdleWait));
+            continue;
+        }
+        cycleStats.recordStart(deadline, now);
 
-        if (storage) {
-            std::vector<SensorRecord> records = convertToRecords(results, config.modbus.sensors);
+        scheduler.due(now, dueIndices);
+        for (size_t index : dueIndices) {
+            uint64_t missed = scheduler.missedDeadlines(index);
+            if (missed > reportedMisses[index]) {
+                std::cerr << "警告: 传感器 " << plan.names[index] << " 错过 "
+                          << (missed - reportedMisses[index]) << " 次轮询截止时间" << std::endl;
+                reportedMisses[index] = missed;
+            }
+        }
+
+        reader.readSensors(plan, dueIndices, results);
+        printSensorData(plan, results);
+
+        if (writer) {
+            convertToRecords(results, plan.names, records);
             if (!records.empty()) {
-                storage->saveBatch(records);
+                writer->submit(records);
+            }
+            if (writer->dropped() > reportedDrops) {
+                std::cerr << "警告: 存储队列已满, 丢弃 " << (writer->dropped() - reportedDrops)
+                          << " 条记录" << std::endl;
+                reportedDrops = writer->dropped();
+            }
+            if (writer->spilled() > reportedSpills) {
+                std::cerr << "警告: 存储队列已满, " << (writer->spilled() - reportedSpills)
+                          << " 条记录溢写到 " << config.storage.spill_path << std::endl;
+                reportedSpills = writer->spilled();
             }
         }
 
-        SLEEP_MS(static_cast<int>(config.getReadInterval().count() * 1000));
+        auto end = PollScheduler::Clock::now();
+        cycleStats.recordEnd(end, scheduler.dueDeadline());
+        if (end >= nextStats) {
+            printCycleStats(cycleStats);
+            if (writer) {
+                std::cout << "存储队列: 当前深度 " << writer->queueDepth() << "/" << writer->queueCapacity()
+                          << ", 最大深度 " << writer->maxQueueDepth() << ", 已写入 " << writer->written()
+                          << " 条, 写入失败 " << writer->failed() << " 条, 重复忽略 " << writer->duplicates()
+                          << " 条" << std::endl;
+            }
+            nextStats = end + kStatsInterval;
+        }
     }
 
     std::cout << std::endl;
+    printCycleStats(cycleStats);
+    if (scheduler.totalMissed() > 0) {
+        std::cout << "共错过 " << scheduler.totalMissed() << " 次轮询截止时间" << std::endl;
+    }
     std::cout << "正在关闭连接..." << std::endl;
-    reader.disconnect();
+    reader.disconnectAll();
+    if (writer) {
+        std::cout << "等待存储队列写入 (" << writer->queueDepth() << " 条)..." << std::endl;
+        writer->stop();
+        std::cout << "存储队列: 最大深度 " << writer->maxQueueDepth() << "/" << writer->queueCapacity()
+                  << ", 已写入 " << writer->written() << " 条, 写入失败 " << writer->failed()
+                  << " 条, 丢弃 " << writer->dropped() << " 条, 溢写 " << writer->spilled() << " 条, 重复忽略 "
+                  << writer->duplicates() << " 条" << std::endl;
+    }
     std::cout << "程序已退出" << std::endl;
 
     return 0;
@@ -0,0 +1,500 @@
+#include "modbus_reactor.h"
+#include "modbus_rtu.h"
+#include <iostream>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <cstring>
+#include <cerrno>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr size_t kMaxRequestLength = 16;
+constexpr int kMaxEvents = 32;
+constexpr uint64_t kWakeupTag = ~static_cast<uint64_t>(0);
+
+timespec toTimespec(std::chrono::steady_clock::time_point tp) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / 1000000000LL);
+    ts.tv_nsec = static_cast<long>(ns % 1000000000LL);
+    return ts;
+}
+
+} // namespace
+
+class ModbusReactor::Impl {
+public:
+    Impl() : epollFd_(epoll_create1(EPOLL_CLOEXEC)), wakeupFd_(-1), pending_(0) {
+        if (epollFd_ < 0) {
+            std::cerr << "无法创建epoll实例: " << std::strerror(errno) << std::endl;
+            return;
+        }
+
+        wakeupFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.u64 = kWakeupTag;
+        if (wakeupFd_ < 0 || epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeupFd_, &ev) != 0) {
+            std::cerr << "无法创建事件通知: " << std::strerror(errno) << std::endl;
+        }
+    }
+
+    ~Impl() {
+        for (auto& channel : channels_) {
+            if (!channel.broken) {
+                epoll_ctl(epollFd_, EPOLL_CTL_DEL, channel.fd, nullptr);
+            }
+            if (channel.timerFd >= 0) {
+                close(channel.timerFd);
+            }
+        }
+        if (wakeupFd_ >= 0) {
+            close(wakeupFd_);
+        }
+        if (epollFd_ >= 0) {
+            close(epollFd_);
+        }
+    }
+
+    bool isValid() const {
+        return epollFd_ >= 0;
+    }
+
+    int nativeHandle() const {
+        return epollFd_;
+    }
+
+    void post(Task task) {
+        {
+            std::lock_guard<std::mutex> lock(postedMutex_);
+            posted_.push_back(std::move(task));
+        }
+        uint64_t one = 1;
+        if (write(wakeupFd_, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+            std::cerr << "无法唤醒事件循环: " << std::strerror(errno) << std::endl;
+        }
+    }
+
+    int addChannel(int fd) {
+        if (epollFd_ < 0 || fd < 0) return -1;
+
+        int timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (timerFd < 0) {
+            std::cerr << "无法创建定时器: " << std::strerror(errno) << std::endl;
+            return -1;
+        }
+
+        int flags = fcntl(fd, F_GETFL, 0);
+        if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0) {
+            std::cerr << "无法将串口设为非阻塞: " << std::strerror(errno) << std::endl;
+            close(timerFd);
+            return -1;
+        }
+
+        int id = static_cast<int>(channels_.size());
+        if (!freeChannels_.empty()) {
+            id = freeChannels_.back();
+        }
+
+        epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.u64 = (static_cast<uint64_t>(id) << 1);
+        if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            std::cerr << "无法注册串口到epoll: " << std::strerror(errno) << std::endl;
+            close(timerFd);
+            return -1;
+        }
+
+        ev.data.u64 = (static_cast<uint64_t>(id) << 1) | 1;
+        if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, timerFd, &ev) != 0) {
+            std::cerr << "无法注册定时器到epoll: " << std::strerror(errno) << std::endl;
+            epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+            close(timerFd);
+            return -1;
+        }
+
+        Channel channel{};
+        channel.fd = fd;
+        channel.timerFd = timerFd;
+        channel.state = State::Idle;
+        channel.broken = false;
+        channel.writing = false;
+        channel.rxLength = 0;
+        channel.head = 0;
+        channel.lastActivity = std::chrono::steady_clock::now();
+        if (id < static_cast<int>(channels_.size())) {
+            freeChannels_.pop_back();
+            channels_[id] = std::move(channel);
+        } else {
+            channels_.push_back(std::move(channel));
+        }
+        return id;
+    }
+
+    void removeChannel(int channelId) {
+        if (channelId < 0 || channelId >= static_cast<int>(channels_.size())) return;
+
+        Channel& channel = channels_[channelId];
+        if (channel.fd < 0) return;
+        if (!channel.broken) {
+            epoll_ctl(epollFd_, EPOLL_CTL_DEL, channel.fd, nullptr);
+            channel.broken = true;
+        }
+        channel.fd = -1;
+        channel.writing = false;
+        if (channel.timerFd >= 0) {
+            epoll_ctl(epollFd_, EPOLL_CTL_DEL, channel.timerFd, nullptr);
+            close(channel.timerFd);
+            channel.timerFd = -1;
+        }
+        channel.state = State::Idle;
+        while (channel.head < channel.queue.size()) {
+            channel.rxLength = 0;
+            complete(channel, TransactionStatus::IoError);
+        }
+        freeChannels_.push_back(channelId);
+    }
+
+    void submit(int channelId, const uint8_t* request, size_t length,
+                std::chrono::microseconds gap, std::chrono::microseconds timeout, Completion done) {
+        if (channelId < 0 || channelId >= static_cast<int>(channels_.size()) || length > kMaxRequestLength) {
+            done(TransactionStatus::IoError, nullptr, 0, std::chrono::microseconds::zero());
+            return;
+        }
+
+        Transaction transaction{};
+        std::memcpy(transaction.request, request, length);
+        transaction.length = length;
+        transaction.gap = gap;
+        transaction.timeout = timeout;
+        transaction.sentAt = std::chrono::steady_clock::now();
+        transaction.done = std::move(done);
+
+        Channel& channel = channels_[channelId];
+        if (channel.broken) {
+            transaction.done(TransactionStatus::IoError, nullptr, 0, std::chrono::microseconds::zero());
+            return;
+        }
+        channel.queue.push_back(std::move(transaction));
+        ++pending_;
+
+        if (channel.state == State::Idle) {
+            startNext(channel);
+        }
+    }
+
+    size_t pending() const {
+        return pending_;
+    }
+
+    void runOnce(int timeoutMs) {
+        epoll_event events[kMaxEvents];
+        int count = epoll_wait(epollFd_, events, kMaxEvents, timeoutMs);
+        if (count < 0) {
+            if (errno != EINTR) {
+                std::cerr << "epoll_wait失败: " << std::strerror(errno) << std::endl;
+            }
+            return;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            if (events[i].data.u64 == kWakeupTag) {
+                runPosted();
+                continue;
+            }
+            Channel& channel = channels_[events[i].data.u64 >> 1];
+            if (channel.fd < 0) {
+                continue;
+            }
+            if (events[i].data.u64 & 1) {
+                onTimer(channel);
+                continue;
+            }
+            if (events[i].events & EPOLLOUT) {
+                onWritable(channel);
+            }
+            if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+                onReadable(channel, events[i].events);
+            }
+        }
+    }
+
+private:
+    enum class State {
+        Idle,
+        Gap,
+        Sending,
+        Waiting
+    };
+
+    struct Transaction {
+        uint8_t request[kMaxRequestLength];
+        size_t length;
+        size_t sent;
+        std::chrono::microseconds gap;
+        std::chrono::microseconds timeout;
+        std::chrono::steady_clock::time_point sentAt;
+        Completion done;
+    };
+
+    struct Channel {
+        int fd;
+        int timerFd;
+        State state;
+        bool broken;
+        bool writing;
+        std::vector<Transaction> queue;
+        size_t head;
+        uint8_t rx[modbus::kMaxFrameLength];
+        size_t rxLength;
+        std::chrono::steady_clock::time_point lastActivity;
+    };
+
+    void runPosted() {
+        uint64_t count;
+        if (read(wakeupFd_, &count, sizeof(count)) < 0) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(postedMutex_);
+            running_.swap(posted_);
+        }
+        for (auto& task : running_) {
+            task();
+        }
+        running_.clear();
+    }
+
+    void armTimer(Channel& channel, std::chrono::steady_clock::time_point deadline) {
+        itimerspec spec;
+        std::memset(&spec, 0, sizeof(spec));
+        spec.it_value = toTimespec(deadline);
+        if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) {
+            spec.it_value.tv_nsec = 1;
+        }
+        timerfd_settime(channel.timerFd, TFD_TIMER_ABSTIME, &spec, nullptr);
+    }
+
+    void disarmTimer(Channel& channel) {
+        itimerspec spec;
+        std::memset(&spec, 0, sizeof(spec));
+        timerfd_settime(channel.timerFd, 0, &spec, nullptr);
+    }
+
+    void watchWritable(Channel& channel, bool writing) {
+        if (channel.writing == writing) return;
+
+        int id = static_cast<int>(&channel - channels_.data());
+        epoll_event ev;
+        ev.events = writing ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+        ev.data.u64 = (static_cast<uint64_t>(id) << 1);
+        if (epoll_ctl(epollFd_, EPOLL_CTL_MOD, channel.fd, &ev) == 0) {
+            channel.writing = writing;
+        }
+    }
+
+    bool sendRequest(Channel& channel, Transaction& transaction) {
+        while (transaction.sent < transaction.length) {
+            ssize_t written = write(channel.fd, transaction.request + transaction.sent,
+                                    transaction.length - transaction.sent);
+            if (written > 0) {
+                transaction.sent += static_cast<size_t>(written);
+                continue;
+            }
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (written < 0 && errno == EAGAIN) {
+                if (channel.state != State::Sending) {
+                    channel.state = State::Sending;
+                    armTimer(channel, transaction.sentAt + transaction.timeout);
+                }
+                watchWritable(channel, true);
+                return true;
+            }
+            watchWritable(channel, false);
+            return false;
+        }
+
+        watchWritable(channel, false);
+        channel.rxLength = 0;
+        channel.state = State::Waiting;
+        armTimer(channel, std::chrono::steady_clock::now() + transaction.timeout);
+        return true;
+    }
+
+    void startNext(Channel& channel) {
+        while (channel.head < channel.queue.size()) {
+            Transaction& transaction = channel.queue[channel.head];
+            auto now = std::chrono::steady_clock::now();
+            auto readyAt = channel.lastActivity + transaction.gap;
+            if (now < readyAt) {
+                channel.state = State::Gap;
+                armTimer(channel, readyAt);
+                return;
+            }
+
+            tcflush(channel.fd, TCIFLUSH);
+            transaction.sentAt = now;
+            transaction.sent = 0;
+            channel.state = State::Idle;
+            if (!sendRequest(channel, transaction)) {
+                channel.lastActivity = now;
+                complete(channel, TransactionStatus::IoError);
+                continue;
+            }
+            return;
+        }
+
+        channel.state = State::Idle;
+        disarmTimer(channel);
+    }
+
+    void complete(Channel& channel, TransactionStatus status) {
+        Transaction transaction = std::move(channel.queue[channel.head]);
+        if (++channel.head == channel.queue.size()) {
+            channel.queue.clear();
+            channel.head = 0;
+        }
+        --pending_;
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            channel.lastActivity - transaction.sentAt);
+        transaction.done(status, channel.rx, channel.rxLength, elapsed);
+    }
+
+    void onWritable(Channel& channel) {
+        if (channel.state != State::Sending) {
+            watchWritable(channel, false);
+            return;
+        }
+        if (!sendRequest(channel, channel.queue[channel.head])) {
+            channel.lastActivity = std::chrono::steady_clock::now();
+            complete(channel, TransactionStatus::IoError);
+            startNext(channel);
+        }
+    }
+
+    void onReadable(Channel& channel, uint32_t events) {
+        uint8_t scratch[modbus::kMaxFrameLength];
+        bool waiting = channel.state == State::Waiting;
+        uint8_t slaveId = waiting ? channel.queue[channel.head].request[0] : 0;
+        uint8_t* target = waiting ? channel.rx + channel.rxLength : scratch;
+        size_t space = waiting ? modbus::responseFrameLength(channel.rx, channel.rxLength, slaveId) - channel.rxLength
+                               : sizeof(scratch);
+
+        ssize_t result = read(channel.fd, target, space);
+        if (result < 0) {
+            if (errno == EAGAIN || errno == EINTR) return;
+        }
+        if (result <= 0 && (events & (EPOLLERR | EPOLLHUP))) {
+            std::cerr << "串口连接已断开" << std::endl;
+            epoll_ctl(epollFd_, EPOLL_CTL_DEL, channel.fd, nullptr);
+            disarmTimer(channel);
+            channel.broken = true;
+            channel.writing = false;
+            channel.state = State::Idle;
+            while (channel.head < channel.queue.size()) {
+                channel.rxLength = 0;
+                complete(channel, TransactionStatus::IoError);
+            }
+            return;
+        }
+        if (!waiting) {
+            if (result > 0) {
+                channel.lastActivity = std::chrono::steady_clock::now();
+            }
+            return;
+        }
+
+        if (result > 0) {
+            channel.rxLength += static_cast<size_t>(result);
+        }
+
+        size_t expected = modbus::responseFrameLength(channel.rx, channel.rxLength, slaveId);
+        if (expected == modbus::kRejectFrame || channel.rxLength == expected) {
+            channel.lastActivity = std::chrono::steady_clock::now();
+            complete(channel, expected == modbus::kRejectFrame ? TransactionStatus::Rejected
+                                                               : TransactionStatus::Completed);
+            startNext(channel);
+        }
+    }
+
+    void onTimer(Channel& channel) {
+        uint64_t expirations;
+        if (read(channel.timerFd, &expirations, sizeof(expirations)) < 0) {
+            return;
+        }
+
+        if (channel.state == State::Sending) {
+            watchWritable(channel, false);
+            tcflush(channel.fd, TCOFLUSH);
+            channel.lastActivity = std::chrono::steady_clock::now();
+            complete(channel, TransactionStatus::Timeout);
+        } else if (channel.state == State::Waiting) {
+            channel.lastActivity = std::chrono::steady_clock::now();
+            complete(channel, TransactionStatus::Timeout);
+        }
+        startNext(channel);
+    }
+
+    int epollFd_;
+    int wakeupFd_;
+    std::vector<Channel> channels_;
+    std::vector<int> freeChannels_;
+    size_t pending_;
+    std::mutex postedMutex_;
+    std::vector<Task> posted_;
+    std::vector<Task> running_;
+};
+
+ModbusReactor::ModbusReactor() : impl_(std::make_unique<Impl>()) {}
+
+ModbusReactor::~ModbusReactor() = default;
+
+bool ModbusReactor::isValid() const {
+    return impl_->isValid();
+}
+
+int ModbusReactor::nativeHandle() const {
+    return impl_->nativeHandle();
+}
+
+int ModbusReactor::addChannel(int fd) {
+    return impl_->addChannel(fd);
+}
+
+void ModbusReactor::removeChannel(int channel) {
+    impl_->removeChannel(channel);
+}
+
+void ModbusReactor::submit(int channel, const uint8_t* request, size_t length,
+                           std::chrono::microseconds gap, std::chrono::microseconds timeout, Completion done) {
+    impl_->submit(channel, request, length, gap, timeout, std::move(done));
+}
+
+void ModbusReactor::post(Task task) {
+    impl_->post(std::move(task));
+}
+
+size_t ModbusReactor::pending() const {
+    return impl_->pending();
+}
+
+void ModbusReactor::run() {
+    while (impl_->pending() > 0) {
+        impl_->runOnce(-1);
+    }
+}
+
+void ModbusReactor::runOnce(int timeoutMs) {
+    impl_->runOnce(timeoutMs);
+}
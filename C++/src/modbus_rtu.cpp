@@ -0,0 +1,72 @@
+#include "modbus_rtu.h"
+#include <algorithm>
+
+namespace modbus {
+
+std::chrono::microseconds interFrameGap(int baudrate, int dataBits, int stopBits, char parity) {
+    if (baudrate <= 0) {
+        return std::chrono::microseconds(4010);
+    }
+    if (baudrate > 19200) {
+        return std::chrono::microseconds(1750);
+    }
+
+    int bitsPerChar = 1 + dataBits + (parity == 'N' ? 0 : 1) + stopBits;
+    long long gapUs = (35LL * bitsPerChar * 1000000LL + 10LL * baudrate - 1) / (10LL * baudrate);
+    return std::chrono::microseconds(gapUs);
+}
+
+std::chrono::microseconds transmissionTime(size_t bytes, int baudrate, int dataBits, int stopBits, char parity) {
+    if (baudrate <= 0) {
+        return std::chrono::microseconds::zero();
+    }
+
+    int bitsPerChar = 1 + dataBits + (parity == 'N' ? 0 : 1) + stopBits;
+    long long timeUs = (static_cast<long long>(bytes) * bitsPerChar * 1000000LL + baudrate - 1) / baudrate;
+    return std::chrono::microseconds(timeUs);
+}
+
+size_t responseFrameLength(const uint8_t* frame, size_t available, uint8_t slaveId) {
+    if (available >= 1 && frame[0] != slaveId) {
+        return kRejectFrame;
+    }
+    if (available < 2) {
+        return kMinResponseLength;
+    }
+
+    uint8_t funcCode = frame[1];
+    if (funcCode & 0x80) {
+        return kMinResponseLength;
+    }
+
+    switch (funcCode) {
+        case 0x01:
+        case 0x02:
+        case 0x03:
+        case 0x04:
+            return available < 3 ? kMinResponseLength : std::min<size_t>(kMinResponseLength + frame[2], kMaxFrameLength);
+        case 0x05:
+        case 0x06:
+        case 0x0F:
+        case 0x10:
+            return 8;
+        default:
+            return kRejectFrame;
+    }
+}
+
+void encodeReadRequest(uint8_t slaveId, uint8_t funcCode, uint16_t regAddr,
+                       uint16_t regCount, uint8_t* out) {
+    out[0] = slaveId;
+    out[1] = funcCode;
+    out[2] = (regAddr >> 8) & 0xFF;
+    out[3] = regAddr & 0xFF;
+    out[4] = (regCount >> 8) & 0xFF;
+    out[5] = regCount & 0xFF;
+
+    uint16_t crc = crc16(out, 6);
+    out[6] = crc & 0xFF;
+    out[7] = (crc >> 8) & 0xFF;
+}
+
+} // namespace modbus
@@ -0,0 +1,326 @@
+#include "modbus_tcp.h"
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #define CLOSE_SOCKET(s) closesocket(s)
+    #define POLL_SOCKET(fds, n, t) WSAPoll(fds, n, t)
+    using socket_t = SOCKET;
+#else
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <netdb.h>
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <unistd.h>
+    #include <cerrno>
+    #define CLOSE_SOCKET(s) close(s)
+    #define POLL_SOCKET(fds, n, t) poll(fds, n, t)
+    #define INVALID_SOCKET (-1)
+    using socket_t = int;
+#endif
+
+namespace {
+
+constexpr size_t kMbapHeaderLength = 7;
+constexpr size_t kMaxAduLength = 260;
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+long long nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+socket_t toSocket(long long handle) {
+    return static_cast<socket_t>(handle);
+}
+
+bool interrupted() {
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEINTR;
+#else
+    return errno == EINTR;
+#endif
+}
+
+bool retryable() {
+#ifdef _WIN32
+    int error = WSAGetLastError();
+    return error == WSAEINTR || error == WSAEWOULDBLOCK;
+#else
+    return errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+}
+
+#ifdef _WIN32
+struct WinsockSession {
+    WinsockSession() {
+        WSADATA wsaData;
+        ready = WSAStartup(MAKEWORD(2, 2), &wsaData) == 0;
+    }
+    ~WinsockSession() {
+        if (ready) WSACleanup();
+    }
+    bool ready;
+};
+
+bool startWinsock() {
+    static WinsockSession session;
+    return session.ready;
+}
+#endif
+
+} // namespace
+
+ModbusTcpClient::ModbusTcpClient(const std::string& host, int port, int timeoutMs, int maxInFlight)
+    : host_(host), port_(port), timeoutMs_(timeoutMs),
+      maxInFlight_(std::max(1, maxInFlight)),
+      socket_(static_cast<long long>(INVALID_SOCKET)), nextTransactionId_(1) {
+    rxBuffer_.reserve(kMaxAduLength * 4);
+    pending_.reserve(maxInFlight_);
+}
+
+ModbusTcpClient::~ModbusTcpClient() {
+    disconnect();
+}
+
+bool ModbusTcpClient::connect() {
+    if (isConnected()) return true;
+
+#ifdef _WIN32
+    if (!startWinsock()) {
+        std::cerr << "无法初始化Winsock" << std::endl;
+        return false;
+    }
+#endif
+
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo* result = nullptr;
+    std::string service = std::to_string(port_);
+    if (getaddrinfo(host_.c_str(), service.c_str(), &hints, &result) != 0 || !result) {
+        std::cerr << "无法解析Modbus TCP地址: " << host_ << std::endl;
+        return false;
+    }
+
+    socket_t sock = INVALID_SOCKET;
+    for (addrinfo* ai = result; ai; ai = ai->ai_next) {
+        sock = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (sock == INVALID_SOCKET) continue;
+
+#ifdef _WIN32
+        u_long nonBlocking = 1;
+        ioctlsocket(sock, FIONBIO, &nonBlocking);
+#else
+        fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+#endif
+
+        int rc = ::connect(sock, ai->ai_addr, static_cast<int>(ai->ai_addrlen));
+        bool inProgress = rc != 0;
+#ifdef _WIN32
+        inProgress = inProgress && WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+        inProgress = inProgress && errno == EINPROGRESS;
+#endif
+        if (rc == 0 || inProgress) {
+            pollfd pfd;
+            pfd.fd = sock;
+            pfd.events = POLLOUT;
+            pfd.revents = 0;
+            int soError = 0;
+            socklen_t len = sizeof(soError);
+            if (rc == 0 ||
+                (POLL_SOCKET(&pfd, 1, timeoutMs_) == 1 &&
+                 getsockopt(sock, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&soError), &len) == 0 &&
+                 soError == 0)) {
+                break;
+            }
+        }
+
+        CLOSE_SOCKET(sock);
+        sock = INVALID_SOCKET;
+    }
+    freeaddrinfo(result);
+
+    if (sock == INVALID_SOCKET) {
+        std::cerr << "无法连接Modbus TCP设备: " << host_ << ":" << port_ << std::endl;
+        return false;
+    }
+
+    int noDelay = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+#ifdef SO_NOSIGPIPE
+    int noSigPipe = 1;
+    setsockopt(sock, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+    socket_ = static_cast<long long>(sock);
+    rxBuffer_.clear();
+    pending_.clear();
+    return true;
+}
+
+void ModbusTcpClient::disconnect() {
+    if (isConnected()) {
+        CLOSE_SOCKET(toSocket(socket_));
+        socket_ = static_cast<long long>(INVALID_SOCKET);
+    }
+    rxBuffer_.clear();
+    pending_.clear();
+}
+
+bool ModbusTcpClient::isConnected() const {
+    return toSocket(socket_) != INVALID_SOCKET;
+}
+
+bool ModbusTcpClient::sendRequest(const TcpReadRequest& request, uint16_t transactionId) {
+    uint8_t adu[12];
+    adu[0] = (transactionId >> 8) & 0xFF;
+    adu[1] = transactionId & 0xFF;
+    adu[2] = 0;
+    adu[3] = 0;
+    adu[4] = 0;
+    adu[5] = 6;
+    adu[6] = request.unit_id;
+    adu[7] = request.function_code;
+    adu[8] = (request.start >> 8) & 0xFF;
+    adu[9] = request.start & 0xFF;
+    adu[10] = (request.count >> 8) & 0xFF;
+    adu[11] = request.count & 0xFF;
+
+    size_t sent = 0;
+    while (sent < sizeof(adu)) {
+        auto result = send(toSocket(socket_), reinterpret_cast<const char*>(adu) + sent,
+                           static_cast<int>(sizeof(adu) - sent), kSendFlags);
+        if (result > 0) {
+            sent += static_cast<size_t>(result);
+            continue;
+        }
+        if (result < 0 && !retryable()) {
+            return false;
+        }
+
+        pollfd pfd;
+        pfd.fd = toSocket(socket_);
+        pfd.events = POLLOUT;
+        pfd.revents = 0;
+        int ready = POLL_SOCKET(&pfd, 1, timeoutMs_);
+        if (ready != 1 && !(ready < 0 && interrupted())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ModbusTcpClient::receive(int timeoutMs) {
+    pollfd pfd;
+    pfd.fd = toSocket(socket_);
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    int ready = POLL_SOCKET(&pfd, 1, timeoutMs);
+    if (ready <= 0) {
+        return ready == 0 || interrupted();
+    }
+
+    uint8_t chunk[1024];
+    auto result = recv(toSocket(socket_), reinterpret_cast<char*>(chunk), sizeof(chunk), 0);
+    if (result < 0 && retryable()) {
+        return true;
+    }
+    if (result <= 0) {
+        return false;
+    }
+    rxBuffer_.insert(rxBuffer_.end(), chunk, chunk + result);
+    return true;
+}
+
+void ModbusTcpClient::execute(const std::vector<TcpReadRequest>& requests, const Completion& done) {
+    if (!isConnected() && !connect()) {
+        for (size_t i = 0; i < requests.size(); ++i) {
+            done(i, nullptr, 0, ReadError::TcpNotConnected);
+        }
+        return;
+    }
+
+    size_t next = 0;
+
+    auto failRemaining = [&](ReadError error) {
+        std::vector<Pending> inFlight;
+        inFlight.swap(pending_);
+        disconnect();
+        for (const auto& p : inFlight) {
+            done(p.index, nullptr, 0, error);
+        }
+        for (; next < requests.size(); ++next) {
+            done(next, nullptr, 0, error);
+        }
+    };
+
+    while (next < requests.size() || !pending_.empty()) {
+        while (next < requests.size() && pending_.size() < static_cast<size_t>(maxInFlight_)) {
+            uint16_t transactionId = nextTransactionId_++;
+            if (nextTransactionId_ == 0) nextTransactionId_ = 1;
+
+            if (!sendRequest(requests[next], transactionId)) {
+                failRemaining(ReadError::TcpSendFailed);
+                return;
+            }
+            pending_.push_back({transactionId, next, nowMs() + timeoutMs_});
+            ++next;
+        }
+
+        long long earliest = pending_.front().deadline_ms;
+        for (const auto& p : pending_) earliest = std::min(earliest, p.deadline_ms);
+        int waitMs = static_cast<int>(std::max(0LL, earliest - nowMs()));
+
+        if (!receive(waitMs)) {
+            failRemaining(ReadError::TcpConnectionLost);
+            return;
+        }
+
+        while (rxBuffer_.size() >= kMbapHeaderLength) {
+            size_t length = (static_cast<size_t>(rxBuffer_[4]) << 8) | rxBuffer_[5];
+            size_t frameLength = 6 + length;
+            if (length < 2 || frameLength > kMaxAduLength) {
+                rxBuffer_.clear();
+                break;
+            }
+            if (rxBuffer_.size() < frameLength) break;
+
+            uint16_t transactionId = static_cast<uint16_t>((rxBuffer_[0] << 8) | rxBuffer_[1]);
+            auto it = std::find_if(pending_.begin(), pending_.end(),
+                                   [transactionId](const Pending& p) { return p.transaction_id == transactionId; });
+            if (it != pending_.end()) {
+                size_t index = it->index;
+                pending_.erase(it);
+                done(index, rxBuffer_.data() + 6, length, ReadError::None);
+            }
+            rxBuffer_.erase(rxBuffer_.begin(), rxBuffer_.begin() + frameLength);
+        }
+
+        long long now = nowMs();
+        for (auto it = pending_.begin(); it != pending_.end();) {
+            if (it->deadline_ms <= now) {
+                size_t index = it->index;
+                it = pending_.erase(it);
+                done(index, nullptr, 0, ReadError::Timeout);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
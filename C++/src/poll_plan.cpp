@@ -0,0 +1,114 @@
+#include "poll_plan.h"
+#include <algorithm>
+#include <iomanip>
+
+namespace {
+
+void printPoint(std::ostream& out, const PointFormat& format, double scale) {
+    out << dataTypeToString(format.type) << "/" << wordOrderToString(format.order) << " x" << scale;
+}
+
+} // namespace
+
+PollPlan PollPlan::compile(const std::vector<SensorConfig>& sensors,
+                           const std::vector<std::string>& portNames,
+                           const PlannerOptions& options) {
+    PollPlan plan;
+    plan.port_names = portNames;
+
+    size_t count = sensors.size();
+    plan.names.reserve(count);
+    plan.slave_ids.reserve(count);
+    plan.ports.reserve(count);
+    plan.temp_scales.reserve(count);
+    plan.humi_scales.reserve(count);
+    plan.temp_formats.reserve(count);
+    plan.humi_formats.reserve(count);
+    plan.periods.reserve(count);
+
+    std::vector<std::chrono::microseconds> groups;
+    for (const auto& sensor : sensors) {
+        auto it = std::find(portNames.begin(), portNames.end(), sensor.port_name);
+        auto period = Config::getPollInterval(sensor);
+
+        plan.names.push_back(sensor.name);
+        plan.slave_ids.push_back(sensor.slave_id);
+        plan.ports.push_back(it == portNames.end() ? kUnbound : static_cast<uint32_t>(it - portNames.begin()));
+        plan.temp_scales.push_back(sensor.temp_scale);
+        plan.humi_scales.push_back(sensor.humi_scale);
+        plan.temp_formats.push_back(sensor.temp_format);
+        plan.humi_formats.push_back(sensor.humi_format);
+        plan.periods.push_back(period);
+
+        if (std::find(groups.begin(), groups.end(), period) == groups.end()) {
+            groups.push_back(period);
+        }
+    }
+
+    std::vector<PlanEntry> entries;
+    for (auto period : groups) {
+        entries.clear();
+        for (size_t i = 0; i < count; ++i) {
+            if (plan.periods[i] != period || plan.ports[i] == kUnbound) continue;
+            const SensorConfig& sensor = sensors[i];
+            entries.push_back({i, plan.ports[i], sensor.slave_id, sensor.function_code,
+                               sensor.temp_reg, sensor.humi_reg,
+                               sensor.temp_format.width, sensor.humi_format.width});
+        }
+        for (auto& block : PollPlanner::plan(entries, options)) {
+            plan.blocks.push_back(std::move(block));
+        }
+    }
+
+    std::stable_sort(plan.blocks.begin(), plan.blocks.end(),
+                     [](const ReadBlock& a, const ReadBlock& b) { return a.port < b.port; });
+
+    plan.port_offsets.assign(portNames.size() + 1, 0);
+    for (const auto& block : plan.blocks) {
+        ++plan.port_offsets[block.port + 1];
+    }
+    for (size_t p = 0; p < portNames.size(); ++p) {
+        plan.port_offsets[p + 1] += plan.port_offsets[p];
+    }
+
+    return plan;
+}
+
+void PollPlan::print(std::ostream& out) const {
+    out << "轮询计划: " << names.size() << " 个传感器, " << port_names.size() << " 个端口, "
+        << blocks.size() << " 个读取请求" << std::endl;
+
+    for (size_t i = 0; i < names.size(); ++i) {
+        out << "  [" << i << "] " << names[i] << ": ";
+        if (ports[i] == kUnbound) {
+            out << "未找到串口" << std::endl;
+            continue;
+        }
+        out << port_names[ports[i]] << " 从站" << static_cast<int>(slave_ids[i])
+            << ", 周期 " << periods[i].count() / 1000.0 << "ms, 温度 ";
+        printPoint(out, temp_formats[i], temp_scales[i]);
+        out << ", 湿度 ";
+        printPoint(out, humi_formats[i], humi_scales[i]);
+        out << std::endl;
+    }
+
+    for (size_t p = 0; p + 1 < port_offsets.size(); ++p) {
+        out << "  端口 " << port_names[p] << ": " << (port_offsets[p + 1] - port_offsets[p])
+            << " 个读取请求" << std::endl;
+        for (size_t b = port_offsets[p]; b < port_offsets[p + 1]; ++b) {
+            const ReadBlock& block = blocks[b];
+            out << "    #" << b << " 从站" << static_cast<int>(block.slave_id)
+                << " 功能码" << static_cast<int>(block.function_code)
+                << " 寄存器 " << block.start << "+" << block.count << " 请求帧";
+            out << std::hex << std::uppercase << std::setfill('0');
+            for (uint8_t byte : block.request) {
+                out << " " << std::setw(2) << static_cast<int>(byte);
+            }
+            out << std::dec << std::nouppercase << std::setfill(' ') << std::endl;
+            for (const auto& slot : block.slots) {
+                out << "      +" << slot.offset << " " << names[slot.sensor]
+                    << (slot.field == SensorField::Temperature ? " 温度" : " 湿度") << std::endl;
+            }
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#include "poll_planner.h"
+#include <algorithm>
+#include <tuple>
+
+namespace {
+
+struct Span {
+    size_t sensor;
+    SensorField field;
+    uint16_t address;
+    uint8_t width;
+};
+
+} // namespace
+
+PlannerOptions PollPlanner::defaultOptions() {
+    PlannerOptions options;
+    options.max_gap = 0;
+    options.max_registers = kMaxReadRegisters;
+    return options;
+}
+
+std::vector<ReadBlock> PollPlanner::plan(const std::vector<PlanEntry>& entries,
+                                         const PlannerOptions& options) {
+    uint16_t maxRegisters = std::max<uint16_t>(1, std::min(options.max_registers, kMaxReadRegisters));
+
+    std::vector<std::tuple<size_t, uint8_t, uint8_t>> groups;
+    std::vector<std::vector<Span>> groupSpans;
+
+    for (const auto& entry : entries) {
+        auto key = std::make_tuple(entry.port, entry.slave_id, entry.function_code);
+        auto it = std::find(groups.begin(), groups.end(), key);
+        size_t group = it - groups.begin();
+        if (it == groups.end()) {
+            groups.push_back(key);
+            groupSpans.emplace_back();
+        }
+        groupSpans[group].push_back({entry.sensor, SensorField::Temperature, entry.temp_reg,
+                                     std::max<uint8_t>(1, entry.temp_width)});
+        groupSpans[group].push_back({entry.sensor, SensorField::Humidity, entry.humi_reg,
+                                     std::max<uint8_t>(1, entry.humi_width)});
+    }
+
+    std::vector<ReadBlock> blocks;
+
+    for (size_t g = 0; g < groups.size(); ++g) {
+        auto& spans = groupSpans[g];
+        std::stable_sort(spans.begin(), spans.end(),
+                         [](const Span& a, const Span& b) { return a.address < b.address; });
+
+        ReadBlock* current = nullptr;
+        for (const auto& span : spans) {
+            uint32_t end = current ? static_cast<uint32_t>(current->start) + current->count : 0;
+            uint32_t newEnd = std::max<uint32_t>(end, static_cast<uint32_t>(span.address) + span.width);
+
+            if (!current || span.address > end + options.max_gap ||
+                newEnd - current->start > maxRegisters) {
+                ReadBlock block{};
+                block.port = std::get<0>(groups[g]);
+                block.slave_id = std::get<1>(groups[g]);
+                block.function_code = std::get<2>(groups[g]);
+                block.start = span.address;
+                block.count = span.width;
+                blocks.push_back(std::move(block));
+                current = &blocks.back();
+            } else {
+                current->count = static_cast<uint16_t>(newEnd - current->start);
+            }
+
+            current->slots.push_back({span.sensor, span.field,
+                                      static_cast<uint16_t>(span.address - current->start)});
+        }
+    }
+
+    for (auto& block : blocks) {
+        modbus::encodeReadRequest(block.slave_id, block.function_code, block.start, block.count,
+                                  block.request.data());
+    }
+
+    return blocks;
+}
@@ -0,0 +1,63 @@
+#include "poll_scheduler.h"
+#include <algorithm>
+
+PollScheduler::PollScheduler(const std::vector<Duration>& periods, Clock::time_point start)
+    : periods_(periods), missed_(periods.size(), 0), totalMissed_(0), dueDeadline_(Clock::time_point::max()) {
+    heap_.reserve(periods_.size());
+    for (size_t i = 0; i < periods_.size(); ++i) {
+        periods_[i] = std::max(periods_[i], Duration(1000));
+        heap_.push_back({start, i});
+    }
+    std::make_heap(heap_.begin(), heap_.end(), later);
+}
+
+bool PollScheduler::later(const Entry& a, const Entry& b) {
+    if (a.deadline != b.deadline) return a.deadline > b.deadline;
+    return a.sensor > b.sensor;
+}
+
+bool PollScheduler::empty() const {
+    return heap_.empty();
+}
+
+PollScheduler::Clock::time_point PollScheduler::nextDeadline() const {
+    return heap_.empty() ? Clock::time_point::max() : heap_.front().deadline;
+}
+
+std::vector<size_t> PollScheduler::due(Clock::time_point now) {
+    std::vector<size_t> sensors;
+    due(now, sensors);
+    return sensors;
+}
+
+void PollScheduler::due(Clock::time_point now, std::vector<size_t>& sensors) {
+    sensors.clear();
+    dueDeadline_ = Clock::time_point::max();
+    while (!heap_.empty() && heap_.front().deadline <= now) {
+        std::pop_heap(heap_.begin(), heap_.end(), later);
+        Entry& entry = heap_.back();
+        sensors.push_back(entry.sensor);
+
+        Duration period = periods_[entry.sensor];
+        auto skipped = (now - entry.deadline) / period;
+        if (skipped > 0) {
+            missed_[entry.sensor] += static_cast<uint64_t>(skipped);
+            totalMissed_ += static_cast<uint64_t>(skipped);
+        }
+        entry.deadline += period * (skipped + 1);
+        dueDeadline_ = std::min(dueDeadline_, entry.deadline);
+        std::push_heap(heap_.begin(), heap_.end(), later);
+    }
+}
+
+PollScheduler::Clock::time_point PollScheduler::dueDeadline() const {
+    return dueDeadline_;
+}
+
+uint64_t PollScheduler::missedDeadlines(size_t sensor) const {
+    return sensor < missed_.size() ? missed_[sensor] : 0;
+}
+
+uint64_t PollScheduler::totalMissed() const {
+    return totalMissed_;
+}
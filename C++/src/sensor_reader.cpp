@@ -1,9 +1,24 @@
 #include "sensor_reader.h"
+#include "modbus_rtu.h"
+#include "poll_planner.h"
+#include "poll_plan.h"
+#include "modbus_tcp.h"
+#include "rtt_estimator.h"
+#ifdef __linux__
+    #include "modbus_reactor.h"
+    #include "serial_linux.h"
+#endif
 #include <iostream>
 #include <thread>
 #include <chrono>
 #include <vector>
 #include <tuple>
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <condition_variable>
+#include <array>
+#include <numeric>
 
 #ifdef _WIN32
     #include <windows.h>
@@ -11,22 +26,244 @@
     #include <termios.h>
     #include <fcntl.h>
     #include <unistd.h>
+    #include <poll.h>
+    #include <cerrno>
     #include <sys/ioctl.h>
+    #define INVALID_HANDLE_VALUE (-1)
 #endif
 
+namespace {
+
+constexpr std::chrono::milliseconds kDefaultMinTimeout(20);
+constexpr uint8_t kSilentBackoffLimit = 2;
+constexpr uint8_t kMaxBackoff = 16;
+
+int registerResponseLength(uint16_t count) {
+    return 5 + 2 * count;
+}
+
+ReadError decodeRegisterResponse(const uint8_t* response, size_t length, uint8_t slaveId, uint8_t funcCode,
+                                 uint16_t count, uint16_t* values) {
+    if (length < 3) {
+        return ReadError::BadLength;
+    }
+
+    if (response[0] != slaveId) {
+        return ReadError::SlaveMismatch;
+    }
+
+    if (response[1] != funcCode) {
+        if (response[1] == (funcCode | 0x80)) {
+            return exceptionError(response[2]);
+        }
+        return ReadError::UnexpectedFunction;
+    }
+
+    if (response[2] != 2 * count || length < 3 + 2 * static_cast<size_t>(count)) {
+        return ReadError::BadLength;
+    }
+
+    for (uint16_t i = 0; i < count; ++i) {
+        values[i] = (static_cast<uint16_t>(response[3 + 2 * i]) << 8) |
+                    static_cast<uint16_t>(response[4 + 2 * i]);
+    }
+    return ReadError::None;
+}
+
+ReadError rejectedFrameError(const uint8_t* frame, uint8_t slaveId) {
+    return frame[0] != slaveId ? ReadError::SlaveMismatch : ReadError::UnexpectedFunction;
+}
+
+ReadError decodeRtuResponse(const uint8_t* response, size_t length, uint8_t slaveId, uint8_t funcCode,
+                            uint16_t count, uint16_t* values) {
+    if (!modbus::checkCrc(response, length)) {
+        return ReadError::CrcMismatch;
+    }
+    return decodeRegisterResponse(response, length - 2, slaveId, funcCode, count, values);
+}
+
+void initSensorData(SensorData& data, uint8_t slaveId, uint32_t sensorId) {
+    data.sensor_id = sensorId;
+    data.slave_id = slaveId;
+    data.error = false;
+    data.offline = false;
+    data.temperature = 0.0;
+    data.humidity = 0.0;
+    data.error_code = ReadError::None;
+}
+
+template <typename ResultFn, typename ValueFn>
+void applyBlockResult(const ReadBlock& block, const uint16_t* values, ReadError error,
+                      ResultFn resultOf, ValueFn valueOf) {
+    for (const auto& slot : block.slots) {
+        SensorData* data = resultOf(slot.sensor);
+        if (!data) continue;
+        if (error != ReadError::None) {
+            data->error = true;
+            if (data->error_code == ReadError::None) {
+                data->error_code = error;
+            }
+            continue;
+        }
+
+        double value = valueOf(slot.sensor, slot.field, values + slot.offset);
+        if (slot.field == SensorField::Temperature) {
+            data->temperature = value;
+        } else {
+            data->humidity = value;
+        }
+    }
+}
+
+template <typename ResultFn>
+void markOffline(const ReadBlock& block, ResultFn resultOf) {
+    for (const auto& slot : block.slots) {
+        SensorData* data = resultOf(slot.sensor);
+        if (!data) continue;
+        data->error = true;
+        data->offline = true;
+        data->error_code = ReadError::Offline;
+    }
+}
+
+constexpr size_t kPlanCacheSize = 8;
+constexpr size_t kNoResult = static_cast<size_t>(-1);
+
+auto allResults(std::vector<SensorData>& results) {
+    return [&results](size_t sensor) { return &results[sensor]; };
+}
+
+auto planResult(std::vector<SensorData>& results, const std::vector<size_t>& resultIndex) {
+    return [&results, &resultIndex](size_t sensor) -> SensorData* {
+        return resultIndex[sensor] == kNoResult ? nullptr : &results[resultIndex[sensor]];
+    };
+}
+
+bool blockDue(const ReadBlock& block, const std::vector<size_t>& resultIndex) {
+    for (const auto& slot : block.slots) {
+        if (resultIndex[slot.sensor] != kNoResult) return true;
+    }
+    return false;
+}
+
+void applyPlanResult(const PollPlan& plan, const ReadBlock& block, const uint16_t* values, ReadError error,
+                     std::vector<SensorData>& results, const std::vector<size_t>& resultIndex) {
+    applyBlockResult(block, values, error, planResult(results, resultIndex),
+                     [&plan](size_t sensor, SensorField field, const uint16_t* registers) {
+                         return plan.value(sensor, field, registers);
+                     });
+}
+
+ReadError gateBlock(SensorReader& reader, const ReadBlock& block) {
+    if (!reader.shouldPoll(block.slave_id)) {
+        return ReadError::Offline;
+    }
+    return reader.isConnected() ? ReadError::None : ReadError::PortDisconnected;
+}
+
+ReadError offlineOr(const SensorReader& reader, const ReadBlock& block, ReadError error) {
+    return reader.isSlaveOffline(block.slave_id) ? ReadError::Offline : error;
+}
+
+bool sameSensorEntry(const MultiPortReader::SensorEntry& a, const MultiPortReader::SensorEntry& b) {
+    return std::get<0>(a) == std::get<0>(b) && std::get<1>(a) == std::get<1>(b) &&
+           std::get<2>(a) == std::get<2>(b) && std::get<3>(a) == std::get<3>(b) &&
+           std::get<4>(a) == std::get<4>(b) && std::get<5>(a) == std::get<5>(b) &&
+           std::get<6>(a) == std::get<6>(b) && std::get<7>(a) == std::get<7>(b) &&
+           std::get<8>(a).decode == std::get<8>(b).decode && std::get<9>(a).decode == std::get<9>(b).decode;
+}
+
+bool samePlanEntry(const PlanEntry& a, const PlanEntry& b) {
+    return a.sensor == b.sensor && a.port == b.port && a.slave_id == b.slave_id &&
+           a.function_code == b.function_code && a.temp_reg == b.temp_reg && a.humi_reg == b.humi_reg &&
+           a.temp_width == b.temp_width && a.humi_width == b.humi_width;
+}
+
+std::vector<SensorConfig> sensorConfigs(const MultiPortReader::SensorList& sensors) {
+    std::vector<SensorConfig> configs;
+    configs.reserve(sensors.size());
+    for (const auto& sensor : sensors) {
+        SensorConfig config{};
+        config.slave_id = std::get<0>(sensor);
+        config.temp_reg = std::get<1>(sensor);
+        config.humi_reg = std::get<2>(sensor);
+        config.temp_scale = std::get<3>(sensor);
+        config.humi_scale = std::get<4>(sensor);
+        config.name = std::get<5>(sensor);
+        config.port_name = std::get<6>(sensor);
+        config.function_code = std::get<7>(sensor);
+        config.temp_format = std::get<8>(sensor);
+        config.humi_format = std::get<9>(sensor);
+        configs.push_back(config);
+    }
+    return configs;
+}
+
+double uint16Value(const uint16_t* registers, double scale) {
+    return defaultPointFormat().decode(registers) * scale;
+}
+
+#ifdef __linux__
+ReadError finishTransaction(SensorReader& reader, const ReadBlock& block, TransactionStatus status,
+                            const uint8_t* frame, size_t length, std::chrono::microseconds elapsed,
+                            uint16_t* values) {
+    if (status == TransactionStatus::Timeout) {
+        reader.recordTimeout(block.slave_id, length > 0);
+        return ReadError::Timeout;
+    }
+    if (status == TransactionStatus::Rejected) {
+        return rejectedFrameError(frame, block.slave_id);
+    }
+    if (status == TransactionStatus::IoError) {
+        return ReadError::IoError;
+    }
+    reader.recordResponse(block.slave_id, length, elapsed);
+    return decodeRtuResponse(frame, length, block.slave_id, block.function_code, block.count, values);
+}
+#endif
+
+} // namespace
+
 class SensorReader::Impl {
 public:
     Impl(const std::string& port, int baudrate, int dataBits,
          int stopBits, char parity, int timeoutMs)
         : port_(port), baudrate_(baudrate), dataBits_(dataBits),
           stopBits_(stopBits), parity_(parity), timeoutMs_(timeoutMs),
-          handle_(INVALID_HANDLE_VALUE), connected_(false) {}
+          frameGap_(modbus::interFrameGap(baudrate, dataBits, stopBits, parity)),
+          maxTimeout_(std::chrono::milliseconds(timeoutMs * 2)),
+          minTimeout_(std::min<std::chrono::microseconds>(kDefaultMinTimeout, maxTimeout_)),
+          lastFrameEnd_(std::chrono::steady_clock::now()),
+          handle_(INVALID_HANDLE_VALUE), connected_(false), serialOptions_(), driverTurnaround_(false) {
+        slaveGaps_.fill(std::chrono::microseconds::zero());
+        backoff_.fill(0);
+        breakerOptions_ = CircuitBreaker::defaultOptions();
+    }
+
+    Impl(const std::string& host, int tcpPort, int timeoutMs, int maxInFlight)
+        : port_(host + ":" + std::to_string(tcpPort)), baudrate_(0), dataBits_(0),
+          stopBits_(0), parity_('N'), timeoutMs_(timeoutMs),
+          frameGap_(std::chrono::microseconds::zero()),
+          maxTimeout_(std::chrono::milliseconds(timeoutMs * 2)),
+          minTimeout_(std::min<std::chrono::microseconds>(kDefaultMinTimeout, maxTimeout_)),
+          lastFrameEnd_(std::chrono::steady_clock::now()),
+          handle_(INVALID_HANDLE_VALUE), connected_(false), serialOptions_(), driverTurnaround_(false),
+          tcp_(std::make_unique<ModbusTcpClient>(host, tcpPort, timeoutMs, maxInFlight)) {
+        slaveGaps_.fill(std::chrono::microseconds::zero());
+        backoff_.fill(0);
+        breakerOptions_ = CircuitBreaker::defaultOptions();
+    }
 
     ~Impl() {
         disconnect();
     }
 
     bool connect() {
+        if (tcp_) {
+            connected_ = tcp_->connect();
+            return connected_;
+        }
+
 #ifdef _WIN32
         std::string adjustedPort = "\\\\.\\" + port_;
         handle_ = CreateFileA(adjustedPort.c_str(),
@@ -58,7 +295,7 @@ public:
         dcbSerialParams.fOutxCtsFlow = FALSE;
         dcbSerialParams.fOutxDsrFlow = FALSE;
         dcbSerialParams.fDtrControl = DTR_CONTROL_ENABLE;
-        dcbSerialParams.fRtsControl = RTS_CONTROL_ENABLE;
+        dcbSerialParams.fRtsControl = serialOptions_.rs485 ? RTS_CONTROL_TOGGLE : RTS_CONTROL_ENABLE;
         dcbSerialParams.fOutX = FALSE;
         dcbSerialParams.fInX = FALSE;
         dcbSerialParams.fErrorChar = FALSE;
@@ -102,13 +339,18 @@ public:
         cfmakeraw(&tty);
 
         speed_t speed;
+        bool customBaudrate = false;
         switch (baudrate_) {
+            case 1200: speed = B1200; break;
+            case 2400: speed = B2400; break;
+            case 4800: speed = B4800; break;
             case 9600: speed = B9600; break;
             case 19200: speed = B19200; break;
             case 38400: speed = B38400; break;
             case 57600: speed = B57600; break;
             case 115200: speed = B115200; break;
-            default: speed = B9600; break;
+            case 230400: speed = B230400; break;
+            default: speed = B9600; customBaudrate = true; break;
         }
 
         cfsetospeed(&tty, speed);
@@ -117,18 +359,19 @@ public:
         tty.c_cflag |= (CLOCAL | CREAD);
         tty.c_cflag &= ~(PARENB | PARODD);
         if (parity_ == 'E') tty.c_cflag |= PARENB;
-        if (parity_ == 'O') tty.c_cflag |= PARODD;
+        if (parity_ == 'O') tty.c_cflag |= (PARENB | PARODD);
 
         tty.c_cflag &= ~CSTOPB;
+        if (stopBits_ == 2) tty.c_cflag |= CSTOPB;
         tty.c_cflag &= ~CSIZE;
-        tty.c_cflag |= CS8;
+        tty.c_cflag |= (dataBits_ == 7) ? CS7 : CS8;
 
         tty.c_lflag = 0;
         tty.c_oflag = 0;
         tty.c_iflag = 0;
 
         tty.c_cc[VMIN] = 0;
-        tty.c_cc[VTIME] = timeoutMs_ / 100;
+        tty.c_cc[VTIME] = 0;
 
         tcflush(handle_, TCIFLUSH);
         if (tcsetattr(handle_, TCSANOW, &tty) != 0) {
@@ -138,12 +381,44 @@ public:
             return false;
         }
 
+        driverTurnaround_ = false;
+#ifdef __linux__
+        if (customBaudrate && !serial::setCustomBaudrate(handle_, baudrate_)) {
+            close(handle_);
+            handle_ = -1;
+            return false;
+        }
+        if (serialOptions_.low_latency && !serial::setLowLatency(handle_)) {
+            std::cerr << "警告: 串口不支持低延迟模式: " << port_ << std::endl;
+        }
+        if (serialOptions_.rs485) {
+            driverTurnaround_ = serial::enableRs485(handle_, serialOptions_.rs485_delay_before_send,
+                                                    serialOptions_.rs485_delay_after_send);
+            if (!driverTurnaround_) {
+                std::cerr << "警告: 串口驱动不支持RS485模式: " << port_ << std::endl;
+            }
+        }
+#else
+        if (customBaudrate) {
+            std::cerr << "不支持的波特率: " << baudrate_ << std::endl;
+            close(handle_);
+            handle_ = -1;
+            return false;
+        }
+#endif
+
         connected_ = true;
         return true;
 #endif
     }
 
     void disconnect() {
+        if (tcp_) {
+            tcp_->disconnect();
+            connected_ = false;
+            return;
+        }
+
         if (connected_) {
 #ifdef _WIN32
             CloseHandle(handle_);
@@ -160,168 +435,327 @@ public:
         return connected_;
     }
 
-    bool sendModbusRequest(uint8_t slaveId, uint8_t funcCode,
-                           uint16_t regAddr, uint16_t regCount) {
+    bool sendModbusRequest(const uint8_t* request) {
         if (!connected_) return false;
 
-        uint8_t request[8];
-        request[0] = slaveId;
-        request[1] = funcCode;
-        request[2] = (regAddr >> 8) & 0xFF;
-        request[3] = regAddr & 0xFF;
-        request[4] = (regCount >> 8) & 0xFF;
-        request[5] = regCount & 0xFF;
-
-        uint16_t crc = calculateCRC(request, 6);
-        request[6] = crc & 0xFF;
-        request[7] = (crc >> 8) & 0xFF;
-
 #ifdef _WIN32
         DWORD bytesWritten;
         WriteFile(handle_, request, 8, &bytesWritten, NULL);
         return bytesWritten == 8;
 #else
+        tcflush(handle_, TCIFLUSH);
         ssize_t result = write(handle_, request, 8);
-        tcdrain(handle_);
+        if (!driverTurnaround_) {
+            tcdrain(handle_);
+        }
         return result == 8;
 #endif
     }
 
-    bool readResponse(uint8_t* buffer, int expectedBytes, int timeoutMs) {
-        if (!connected_) return false;
+    int readResponse(uint8_t* buffer, uint8_t slaveId, std::chrono::steady_clock::time_point deadline) {
+        if (!connected_) return -1;
 
-        int bytesRead = 0;
-        auto startTime = std::chrono::steady_clock::now();
+        size_t bytesRead = 0;
+        size_t expectedBytes = modbus::kMinResponseLength;
 
         while (bytesRead < expectedBytes) {
-            auto elapsed = std::chrono::steady_clock::now() - startTime;
-            if (std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() > timeoutMs) {
+            auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0) {
                 break;
             }
 
 #ifdef _WIN32
-            DWORD avail = 0;
-            if (!PurgeComm(handle_, PURGE_RXCLEAR)) {
-                return false;
-            }
-            COMSTAT stat;
-            if (ClearCommError(handle_, NULL, &stat) && stat.cbInQue > 0) {
-                DWORD toRead = std::min<DWORD>(expectedBytes - bytesRead, stat.cbInQue);
-                DWORD bytes;
-                if (ReadFile(handle_, buffer + bytesRead, toRead, &bytes, NULL)) {
-                    bytesRead += bytes;
-                }
+            COMMTIMEOUTS timeouts = {0};
+            timeouts.ReadIntervalTimeout = MAXDWORD;
+            timeouts.ReadTotalTimeoutMultiplier = MAXDWORD;
+            timeouts.ReadTotalTimeoutConstant = static_cast<DWORD>(remaining);
+            timeouts.WriteTotalTimeoutConstant = timeoutMs_;
+            SetCommTimeouts(handle_, &timeouts);
+
+            DWORD bytes = 0;
+            if (!ReadFile(handle_, buffer + bytesRead, static_cast<DWORD>(expectedBytes - bytesRead), &bytes, NULL)) {
+                return -1;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            bytesRead += bytes;
+            expectedBytes = modbus::responseFrameLength(buffer, bytesRead, slaveId);
 #else
-            int avail = 0;
-            ioctl(handle_, FIONREAD, &avail);
-            if (avail > 0) {
-                int toRead = std::min(expectedBytes - bytesRead, avail);
-                ssize_t result = read(handle_, buffer + bytesRead, toRead);
-                if (result > 0) {
-                    bytesRead += result;
-                }
+            struct pollfd pfd;
+            pfd.fd = handle_;
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+
+            int ready = poll(&pfd, 1, static_cast<int>(remaining));
+            if (ready < 0) {
+                if (errno == EINTR) continue;
+                return -1;
+            }
+            if (ready == 0) {
+                break;
+            }
+            if (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) {
+                return -1;
+            }
+
+            ssize_t result = read(handle_, buffer + bytesRead, expectedBytes - bytesRead);
+            if (result > 0) {
+                bytesRead += static_cast<size_t>(result);
+                expectedBytes = modbus::responseFrameLength(buffer, bytesRead, slaveId);
+            } else if (result < 0 && errno != EAGAIN && errno != EINTR) {
+                return -1;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
 #endif
         }
 
-        return bytesRead == expectedBytes;
+        return static_cast<int>(bytesRead);
     }
 
-    SensorData readRawData(uint8_t slaveId, uint16_t tempReg,
-                           uint16_t humiReg) {
-        SensorData result;
-        result.slave_id = slaveId;
-        result.error = true;
-        result.temperature = 0.0;
-        result.humidity = 0.0;
-
+    bool readRegisters(uint8_t slaveId, uint8_t funcCode, uint16_t start, uint16_t count,
+                       uint16_t* values, ReadError& error) {
         if (!connected_) {
-            result.error_message = "未连接设备";
-            return result;
+            error = ReadError::NotConnected;
+            return false;
         }
 
-        uint8_t response[64];
-        int expectedBytes = 5 + 4;
+        if (count == 0 || count > PollPlanner::kMaxReadRegisters) {
+            error = ReadError::InvalidCount;
+            return false;
+        }
 
-        if (!sendModbusRequest(slaveId, 0x03, tempReg, 2)) {
-            result.error_message = "发送读取请求失败";
-            return result;
+        if (tcp_) {
+            tcpRequests_.assign(1, {slaveId, funcCode, start, count});
+            struct {
+                uint16_t* values;
+                ReadError* error;
+            } target{values, &error};
+            tcp_->execute(tcpRequests_, [this, &target](size_t, const uint8_t* adu, size_t length, ReadError tcpError) {
+                const TcpReadRequest& request = tcpRequests_[0];
+                recordTcpResult(request.unit_id, tcpError);
+                *target.error = tcpError == ReadError::None
+                    ? decodeRegisterResponse(adu, length, request.unit_id, request.function_code,
+                                             request.count, target.values)
+                    : tcpError;
+            });
+            return error == ReadError::None;
         }
 
-        if (!readResponse(response, expectedBytes, timeoutMs_ * 2)) {
-            result.error_message = "读取响应超时";
-            return result;
+        uint8_t request[modbus::kReadRequestLength];
+        modbus::encodeReadRequest(slaveId, funcCode, start, count, request);
+        return transact(slaveId, funcCode, count, request, values, error);
+    }
+
+    bool readBlock(const ReadBlock& block, uint16_t* values, ReadError& error) {
+        if (!connected_ || tcp_) {
+            return readRegisters(block.slave_id, block.function_code, block.start, block.count, values, error);
         }
+        return transact(block.slave_id, block.function_code, block.count, block.request.data(), values, error);
+    }
+
+    bool transact(uint8_t slaveId, uint8_t funcCode, uint16_t count, const uint8_t* request,
+                  uint16_t* values, ReadError& error) {
+        uint8_t response[modbus::kMaxFrameLength];
+
+        int expected = registerResponseLength(count);
 
-        if (response[0] != slaveId) {
-            result.error_message = "从站地址不匹配";
-            return result;
+        std::this_thread::sleep_until(lastFrameEnd_ + frameGap(slaveId));
+
+        auto sentAt = std::chrono::steady_clock::now();
+        if (!sendModbusRequest(request)) {
+            lastFrameEnd_ = std::chrono::steady_clock::now();
+            error = ReadError::SendFailed;
+            return false;
+        }
+
+        int received = readResponse(response, slaveId, sentAt + responseTimeout(slaveId, expected));
+        lastFrameEnd_ = std::chrono::steady_clock::now();
+        size_t frameLength = received < 0 ? 0 : modbus::responseFrameLength(response, received, slaveId);
+        if (received > 0 && frameLength == modbus::kRejectFrame) {
+            error = rejectedFrameError(response, slaveId);
+            return false;
+        }
+        if (received < 0) {
+            error = ReadError::IoError;
+            return false;
+        }
+        if (static_cast<size_t>(received) != frameLength) {
+            recordTimeout(slaveId, received > 0);
+            error = ReadError::Timeout;
+            return false;
         }
+        recordResponse(slaveId, received,
+                       std::chrono::duration_cast<std::chrono::microseconds>(lastFrameEnd_ - sentAt));
+
+        error = decodeRtuResponse(response, received, slaveId, funcCode, count, values);
+        return error == ReadError::None;
+    }
+
+    void readRegisterBlocks(const std::vector<const ReadBlock*>& blocks,
+                            const SensorReader::BlockCompletion& done) {
+        uint16_t values[PollPlanner::kMaxReadRegisters];
 
-        if (response[1] != 0x03) {
-            if (response[1] == 0x83) {
-                result.error_message = "Modbus异常响应: " + std::to_string(response[2]);
-            } else {
-                result.error_message = "未知功能码响应";
+        if (!tcp_ || !connected_) {
+            for (size_t i = 0; i < blocks.size(); ++i) {
+                ReadError error = ReadError::None;
+                readBlock(*blocks[i], values, error);
+                done(i, values, error);
             }
-            return result;
+            return;
         }
 
-        if (response[2] != 4) {
-            result.error_message = "数据长度不正确";
-            return result;
+        tcpRequests_.clear();
+        for (const ReadBlock* block : blocks) {
+            tcpRequests_.push_back({block->slave_id, block->function_code, block->start, block->count});
         }
 
-        uint16_t tempRaw = (static_cast<uint16_t>(response[3]) << 8) |
-                          static_cast<uint16_t>(response[4]);
-        uint16_t humiRaw = (static_cast<uint16_t>(response[5]) << 8) |
-                          static_cast<uint16_t>(response[6]);
+        struct {
+            const std::vector<const ReadBlock*>& blocks;
+            uint16_t* values;
+            const SensorReader::BlockCompletion& done;
+        } target{blocks, values, done};
+        tcp_->execute(tcpRequests_, [this, &target](size_t index, const uint8_t* adu, size_t length,
+                                                    ReadError tcpError) {
+            const ReadBlock& block = *target.blocks[index];
+            recordTcpResult(block.slave_id, tcpError);
+            ReadError error = tcpError == ReadError::None
+                ? decodeRegisterResponse(adu, length, block.slave_id, block.function_code, block.count,
+                                         target.values)
+                : tcpError;
+            target.done(index, target.values, error);
+        });
+    }
 
-        result.temperature = static_cast<double>(tempRaw) / 10.0;
-        result.humidity = static_cast<double>(humiRaw) / 10.0;
-        result.error = false;
-        result.error_message.clear();
+#ifndef _WIN32
+    int nativeHandle() const {
+        return connected_ && !tcp_ ? handle_ : -1;
+    }
+#endif
 
-        return result;
+    int timeoutMs() const {
+        return timeoutMs_;
     }
 
-private:
-    uint16_t calculateCRC(const uint8_t* data, int length) {
-        uint16_t crc = 0xFFFF;
-        for (int i = 0; i < length; i++) {
-            crc ^= static_cast<uint16_t>(data[i]);
-            for (int j = 0; j < 8; j++) {
-                if (crc & 0x0001) {
-                    crc = (crc >> 1) ^ 0xA001;
-                } else {
-                    crc >>= 1;
-                }
-            }
+    std::chrono::microseconds frameGap(uint8_t slaveId) const {
+        return slaveGaps_[slaveId] > std::chrono::microseconds::zero() ? slaveGaps_[slaveId] : frameGap_;
+    }
+
+    void setSlaveGap(uint8_t slaveId, std::chrono::microseconds gap) {
+        slaveGaps_[slaveId] = gap;
+    }
+
+    void setSerialOptions(const SerialOptions& options) {
+        serialOptions_ = options;
+    }
+
+    void setTimeoutBounds(std::chrono::microseconds minimum, std::chrono::microseconds maximum) {
+        maxTimeout_ = maximum;
+        minTimeout_ = std::min(minimum, maximum);
+    }
+
+    std::chrono::microseconds responseTimeout(uint8_t slaveId, size_t responseLength) const {
+        const RttEstimator& estimate = rtt_[slaveId].hasSamples() ? rtt_[slaveId] : portRtt_;
+        auto timeout = estimate.timeout(minTimeout_, maxTimeout_);
+        for (uint8_t i = 0; i < backoff_[slaveId] && timeout < maxTimeout_; ++i) {
+            timeout = std::min(timeout * 2, maxTimeout_);
+        }
+        return timeout + modbus::transmissionTime(modbus::kReadRequestLength + responseLength,
+                                                  baudrate_, dataBits_, stopBits_, parity_);
+    }
+
+    void recordResponse(uint8_t slaveId, size_t responseLength, std::chrono::microseconds elapsed) {
+        auto wireTime = modbus::transmissionTime(modbus::kReadRequestLength + responseLength,
+                                                 baudrate_, dataBits_, stopBits_, parity_);
+        auto rtt = elapsed > wireTime ? elapsed - wireTime : std::chrono::microseconds::zero();
+        rtt_[slaveId].sample(rtt);
+        portRtt_.sample(rtt);
+        backoff_[slaveId] = 0;
+        breakers_[slaveId].onSuccess();
+    }
+
+    void recordTimeout(uint8_t slaveId, bool partial) {
+        uint8_t limit = partial ? kMaxBackoff : kSilentBackoffLimit;
+        if (backoff_[slaveId] < limit) {
+            ++backoff_[slaveId];
+        }
+        if (partial) {
+            breakers_[slaveId].onSuccess();
+        } else {
+            breakers_[slaveId].onFailure(std::chrono::steady_clock::now(), breakerOptions_);
+        }
+    }
+
+    void recordTcpResult(uint8_t slaveId, ReadError error) {
+        if (error == ReadError::None) {
+            breakers_[slaveId].onSuccess();
+        } else if (error == ReadError::Timeout) {
+            breakers_[slaveId].onFailure(std::chrono::steady_clock::now(), breakerOptions_);
         }
-        return crc;
     }
 
+    void setBreakerOptions(const BreakerOptions& options) {
+        breakerOptions_ = options;
+    }
+
+    bool shouldPoll(uint8_t slaveId) {
+        return breakers_[slaveId].allow(std::chrono::steady_clock::now());
+    }
+
+    bool isSlaveOffline(uint8_t slaveId) const {
+        return breakers_[slaveId].isOpen();
+    }
+
+    std::vector<PlanEntry>& planEntries() {
+        entries_.clear();
+        return entries_;
+    }
+
+    const std::vector<ReadBlock>& planBlocks() {
+        if (!std::equal(entries_.begin(), entries_.end(), plannedEntries_.begin(), plannedEntries_.end(),
+                        samePlanEntry)) {
+            blocks_ = PollPlanner::plan(entries_, PollPlanner::defaultOptions());
+            plannedEntries_ = entries_;
+        }
+        return blocks_;
+    }
+
+private:
     std::string port_;
     int baudrate_;
     int dataBits_;
     int stopBits_;
     char parity_;
     int timeoutMs_;
+    std::chrono::microseconds frameGap_;
+    std::array<std::chrono::microseconds, 256> slaveGaps_;
+    std::chrono::microseconds maxTimeout_;
+    std::chrono::microseconds minTimeout_;
+    std::array<RttEstimator, 256> rtt_;
+    std::array<uint8_t, 256> backoff_;
+    RttEstimator portRtt_;
+    std::array<CircuitBreaker, 256> breakers_;
+    BreakerOptions breakerOptions_;
+    std::chrono::steady_clock::time_point lastFrameEnd_;
 #ifdef _WIN32
     HANDLE handle_;
 #else
     int handle_;
 #endif
     bool connected_;
+    SerialOptions serialOptions_;
+    bool driverTurnaround_;
+    std::unique_ptr<ModbusTcpClient> tcp_;
+    std::vector<TcpReadRequest> tcpRequests_;
+    std::vector<PlanEntry> entries_;
+    std::vector<PlanEntry> plannedEntries_;
+    std::vector<ReadBlock> blocks_;
 };
 
 SensorReader::SensorReader(const std::string& port, int baudrate, int dataBits,
                            int stopBits, char parity, int timeoutMs)
     : impl_(std::make_unique<Impl>(port, baudrate, dataBits, stopBits, parity, timeoutMs)) {}
 
+SensorReader::SensorReader(const std::string& host, int tcpPort, int timeoutMs, int maxInFlight)
+    : impl_(std::make_unique<Impl>(host, tcpPort, timeoutMs, maxInFlight)) {}
+
 SensorReader::~SensorReader() {
     disconnect();
 }
@@ -338,36 +772,129 @@ bool SensorReader::isConnected() const {
     return impl_->isConnected();
 }
 
+int SensorReader::nativeHandle() const {
+#ifdef _WIN32
+    return -1;
+#else
+    return impl_->nativeHandle();
+#endif
+}
+
+int SensorReader::timeoutMs() const {
+    return impl_->timeoutMs();
+}
+
+std::chrono::microseconds SensorReader::frameGap(uint8_t slaveId) const {
+    return impl_->frameGap(slaveId);
+}
+
+void SensorReader::setSlaveGap(uint8_t slaveId, std::chrono::microseconds gap) {
+    impl_->setSlaveGap(slaveId, gap);
+}
+
+void SensorReader::setSerialOptions(const SerialOptions& options) {
+    impl_->setSerialOptions(options);
+}
+
+void SensorReader::setTimeoutBounds(std::chrono::microseconds minimum, std::chrono::microseconds maximum) {
+    impl_->setTimeoutBounds(minimum, maximum);
+}
+
+std::chrono::microseconds SensorReader::responseTimeout(uint8_t slaveId, size_t responseLength) const {
+    return impl_->responseTimeout(slaveId, responseLength);
+}
+
+void SensorReader::recordResponse(uint8_t slaveId, size_t responseLength, std::chrono::microseconds elapsed) {
+    impl_->recordResponse(slaveId, responseLength, elapsed);
+}
+
+void SensorReader::recordTimeout(uint8_t slaveId, bool partial) {
+    impl_->recordTimeout(slaveId, partial);
+}
+
+void SensorReader::setBreakerOptions(const BreakerOptions& options) {
+    impl_->setBreakerOptions(options);
+}
+
+bool SensorReader::shouldPoll(uint8_t slaveId) {
+    return impl_->shouldPoll(slaveId);
+}
+
+bool SensorReader::isSlaveOffline(uint8_t slaveId) const {
+    return impl_->isSlaveOffline(slaveId);
+}
+
+bool SensorReader::readRegisters(uint8_t slaveId, uint8_t funcCode, uint16_t start, uint16_t count,
+                                 uint16_t* values, ReadError& error) {
+    return impl_->readRegisters(slaveId, funcCode, start, count, values, error);
+}
+
+void SensorReader::readRegisterBlocks(const std::vector<const ReadBlock*>& blocks,
+                                      const BlockCompletion& done) {
+    impl_->readRegisterBlocks(blocks, done);
+}
+
 SensorData SensorReader::readSensor(uint8_t slaveId, uint16_t tempReg,
-                                    uint16_t humiReg, double tempScale,
-                                    double humiScale, const std::string& sensorName) {
-    SensorData result = impl_->readRawData(slaveId, tempReg, humiReg);
-    result.name = sensorName;
-    result.slave_id = slaveId;
-    result.temperature *= tempScale;
-    result.humidity *= humiScale;
+                                    uint16_t humiReg, double tempScale, double humiScale) {
+    SensorData result;
+    initSensorData(result, slaveId, 0);
+    impl_->planEntries().push_back({0, 0, slaveId, 0x03, tempReg, humiReg, 1, 1});
+
+    auto resultOf = [&result](size_t) { return &result; };
+    uint16_t values[PollPlanner::kMaxReadRegisters];
+    for (const auto& block : impl_->planBlocks()) {
+        if (!shouldPoll(block.slave_id)) {
+            markOffline(block, resultOf);
+            continue;
+        }
+        ReadError error = ReadError::None;
+        readRegisters(block.slave_id, block.function_code, block.start, block.count, values, error);
+        applyBlockResult(block, values, error, resultOf,
+                         [tempScale, humiScale](size_t, SensorField field, const uint16_t* registers) {
+                             return uint16Value(registers, field == SensorField::Temperature ? tempScale : humiScale);
+                         });
+        if (isSlaveOffline(block.slave_id)) {
+            markOffline(block, resultOf);
+        }
+    }
+
     return result;
 }
 
-std::vector<SensorData> SensorReader::readAllSensors(
-    const std::vector<std::tuple<uint8_t, uint16_t, uint16_t, double, double, std::string>>& sensors) {
+std::vector<SensorData> SensorReader::readAllSensors(const SensorList& sensors) {
     std::vector<SensorData> results;
-    results.reserve(sensors.size());
+    readAllSensors(sensors, results);
+    return results;
+}
 
-    for (const auto& sensor : sensors) {
-        SensorData data = readSensor(
-            std::get<0>(sensor),
-            std::get<1>(sensor),
-            std::get<2>(sensor),
-            std::get<3>(sensor),
-            std::get<4>(sensor),
-            std::get<5>(sensor)
-        );
-        results.push_back(data);
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+void SensorReader::readAllSensors(const SensorList& sensors, std::vector<SensorData>& results) {
+    results.resize(sensors.size());
+    std::vector<PlanEntry>& entries = impl_->planEntries();
+
+    for (size_t i = 0; i < sensors.size(); ++i) {
+        const auto& sensor = sensors[i];
+        initSensorData(results[i], std::get<0>(sensor), static_cast<uint32_t>(i));
+        entries.push_back({i, 0, std::get<0>(sensor), 0x03, std::get<1>(sensor), std::get<2>(sensor), 1, 1});
     }
 
-    return results;
+    uint16_t values[PollPlanner::kMaxReadRegisters];
+    for (const auto& block : impl_->planBlocks()) {
+        if (!shouldPoll(block.slave_id)) {
+            markOffline(block, allResults(results));
+            continue;
+        }
+        ReadError error = ReadError::None;
+        readRegisters(block.slave_id, block.function_code, block.start, block.count, values, error);
+        applyBlockResult(block, values, error, allResults(results),
+                         [&sensors](size_t sensor, SensorField field, const uint16_t* registers) {
+                             return uint16Value(registers, field == SensorField::Temperature
+                                                               ? std::get<3>(sensors[sensor])
+                                                               : std::get<4>(sensors[sensor]));
+                         });
+        if (isSlaveOffline(block.slave_id)) {
+            markOffline(block, allResults(results));
+        }
+    }
 }
 
 std::string SensorReader::getDefaultPort() {
@@ -378,9 +905,77 @@ std::string SensorReader::getDefaultPort() {
 #endif
 }
 
-MultiPortReader::MultiPortReader() = default;
+class MultiPortReader::PortWorker {
+public:
+    explicit PortWorker(const RealtimeOptions& realtime)
+        : realtime_(realtime), busy_(false), stopping_(false), thread_([this] { run(); }) {}
+
+    ~PortWorker() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wakeup_.notify_one();
+        thread_.join();
+    }
+
+    void post(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        wakeup_.notify_one();
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return tasks_.empty() && !busy_; });
+    }
+
+private:
+    void run() {
+        if (realtime_.priority > 0 || !realtime_.cpus.empty()) {
+            cycle::applyRealtime(realtime_);
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            wakeup_.wait(lock, [this] { return !tasks_.empty() || stopping_; });
+            if (stopping_) break;
+
+            running_.swap(tasks_);
+            busy_ = true;
+            lock.unlock();
+            for (auto& task : running_) {
+                task();
+            }
+            running_.clear();
+            lock.lock();
+
+            busy_ = false;
+            done_.notify_all();
+        }
+    }
+
+    RealtimeOptions realtime_;
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::condition_variable done_;
+    std::vector<std::function<void()>> tasks_;
+    std::vector<std::function<void()>> running_;
+    bool busy_;
+    bool stopping_;
+    std::thread thread_;
+};
+
+MultiPortReader::MultiPortReader()
+    : plannerOptions_(PollPlanner::defaultOptions()), breakerOptions_(CircuitBreaker::defaultOptions()),
+      realtimeOptions_{0, {}}, pollMode_(PollMode::Parallel), loopRunning_(false), asyncPending_(0),
+      planCacheNext_(0), cycle_{nullptr, nullptr, nullptr} {}
 
 MultiPortReader::~MultiPortReader() {
+    stopEventLoop();
+    workers_.clear();
+    reactor_.reset();
     disconnectAll();
 }
 
@@ -390,7 +985,27 @@ bool MultiPortReader::addPort(const std::string& name, const std::string& port,
         return false;
     }
     readers_.push_back(std::make_unique<SensorReader>(port, baudrate, dataBits, stopBits, parity, timeoutMs));
+    readers_.back()->setBreakerOptions(breakerOptions_);
     portNames_.push_back(name);
+    workers_.push_back(nullptr);
+    reactorChannels_.push_back(-1);
+    portBlocks_.emplace_back();
+    portBlockPointers_.emplace_back();
+    return true;
+}
+
+bool MultiPortReader::addTcpPort(const std::string& name, const std::string& host, int tcpPort,
+                                 int timeoutMs, int maxInFlight) {
+    if (readers_.size() >= 16) {
+        return false;
+    }
+    readers_.push_back(std::make_unique<SensorReader>(host, tcpPort, timeoutMs, maxInFlight));
+    readers_.back()->setBreakerOptions(breakerOptions_);
+    portNames_.push_back(name);
+    workers_.push_back(nullptr);
+    reactorChannels_.push_back(-1);
+    portBlocks_.emplace_back();
+    portBlockPointers_.emplace_back();
     return true;
 }
 
@@ -400,6 +1015,11 @@ bool MultiPortReader::connectAll() {
         if (readers_[i]->connect()) {
             connected++;
             std::cout << "已连接串口: " << portNames_[i] << std::endl;
+            if (reactor_ && loopRunning_) {
+                reactor_->post([this, i] { registerChannel(i); });
+            } else if (reactor_) {
+                registerChannel(i);
+            }
         } else {
             std::cerr << "无法连接串口: " << portNames_[i] << std::endl;
         }
@@ -408,56 +1028,519 @@ bool MultiPortReader::connectAll() {
 }
 
 void MultiPortReader::disconnectAll() {
+    reactor_.reset();
+    reactorChannels_.assign(readers_.size(), -1);
     for (auto& reader : readers_) {
         reader->disconnect();
     }
 }
 
-std::vector<SensorData> MultiPortReader::readAllSensors(
-    const std::vector<std::tuple<uint8_t, uint16_t, uint16_t, double, double, std::string, std::string>>& sensors) {
+void MultiPortReader::setPollMode(PollMode mode) {
+    pollMode_ = mode;
+}
+
+PollMode MultiPortReader::getPollMode() const {
+    return pollMode_;
+}
+
+void MultiPortReader::setPlannerOptions(const PlannerOptions& options) {
+    plannerOptions_ = options;
+    planCache_.clear();
+    planCacheNext_ = 0;
+}
+
+void MultiPortReader::setRealtimeOptions(const RealtimeOptions& options) {
+    realtimeOptions_ = options;
+    for (auto& worker : workers_) {
+        worker.reset();
+    }
+}
+
+void MultiPortReader::setBreakerOptions(const BreakerOptions& options) {
+    breakerOptions_ = options;
+    for (auto& reader : readers_) {
+        reader->setBreakerOptions(options);
+    }
+}
+
+void MultiPortReader::readPortBlocks(size_t portIndex) {
+    SensorReader& reader = *readers_[portIndex];
+    const CycleContext& cycle = cycle_;
+
+    if (!reader.isConnected()) {
+        for (size_t blockIndex : portBlocks_[portIndex]) {
+            applyPlanResult(*cycle.plan, cycle.plan->blocks[blockIndex], nullptr, ReadError::PortDisconnected,
+                            *cycle.results, *cycle.resultIndex);
+        }
+        return;
+    }
+
+    std::vector<const ReadBlock*>& pointers = portBlockPointers_[portIndex];
+    pointers.clear();
+    for (size_t blockIndex : portBlocks_[portIndex]) {
+        pointers.push_back(&cycle.plan->blocks[blockIndex]);
+    }
+
+    struct {
+        const std::vector<const ReadBlock*>& pointers;
+        const CycleContext& cycle;
+    } target{pointers, cycle};
+    reader.readRegisterBlocks(pointers, [&target](size_t index, const uint16_t* values, ReadError error) {
+        applyPlanResult(*target.cycle.plan, *target.pointers[index], values, error, *target.cycle.results,
+                        *target.cycle.resultIndex);
+    });
+}
+
+PollPlan MultiPortReader::compilePlan(const std::vector<SensorConfig>& sensors) const {
+    return PollPlan::compile(sensors, portNames_, plannerOptions_);
+}
+
+void MultiPortReader::beginCycle(const PollPlan& plan, const std::vector<size_t>& due,
+                                 std::vector<SensorData>& results, std::vector<size_t>& resultIndex) {
+    results.resize(due.size());
+    resultIndex.assign(plan.size(), kNoResult);
+
+    for (size_t i = 0; i < due.size(); ++i) {
+        size_t sensor = due[i];
+        SensorData& data = results[i];
+        initSensorData(data, plan.slave_ids[sensor], static_cast<uint32_t>(sensor));
+        resultIndex[sensor] = i;
+
+        if (plan.ports[sensor] >= readers_.size()) {
+            data.error = true;
+            data.error_code = ReadError::PortNotFound;
+        }
+    }
+}
+
+const std::shared_ptr<const PollPlan>& MultiPortReader::cachedPlan(const SensorList& sensors) {
+    for (const auto& cached : planCache_) {
+        if (std::equal(cached.sensors.begin(), cached.sensors.end(), sensors.begin(), sensors.end(),
+                       sameSensorEntry)) {
+            return cached.plan;
+        }
+    }
+
+    if (planCache_.size() < kPlanCacheSize) {
+        planCache_.emplace_back();
+        planCacheNext_ = planCache_.size() - 1;
+    }
+    CachedPlan& slot = planCache_[planCacheNext_];
+    planCacheNext_ = (planCacheNext_ + 1) % kPlanCacheSize;
+    slot.sensors = sensors;
+    slot.plan = std::make_shared<const PollPlan>(compilePlan(sensorConfigs(sensors)));
+    return slot.plan;
+}
+
+std::vector<SensorData> MultiPortReader::readAllSensors(const SensorList& sensors) {
     std::vector<SensorData> results;
-    results.reserve(sensors.size());
+    readAllSensors(sensors, results);
+    return results;
+}
 
-    for (const auto& sensor : sensors) {
-        uint8_t slaveId = std::get<0>(sensor);
-        uint16_t tempReg = std::get<1>(sensor);
-        uint16_t humiReg = std::get<2>(sensor);
-        double tempScale = std::get<3>(sensor);
-        double humiScale = std::get<4>(sensor);
-        std::string sensorName = std::get<5>(sensor);
-        std::string portName = std::get<6>(sensor);
-
-        SensorData data;
-        data.name = sensorName;
-        data.slave_id = slaveId;
-        data.error = true;
-        data.temperature = 0.0;
-        data.humidity = 0.0;
-
-        bool found = false;
-        for (size_t i = 0; i < portNames_.size(); ++i) {
-            if (portNames_[i] == portName) {
-                if (readers_[i]->isConnected()) {
-                    data = readers_[i]->readSensor(slaveId, tempReg, humiReg, tempScale, humiScale, sensorName);
-                    data.temperature *= tempScale;
-                    data.humidity *= humiScale;
-                } else {
-                    data.error_message = "串口未连接: " + portName;
-                }
-                found = true;
-                break;
+void MultiPortReader::readAllSensors(const SensorList& sensors, std::vector<SensorData>& results) {
+    if (loopRunning_ && std::this_thread::get_id() != loopThread_.get_id()) {
+        results = readAllSensorsAsync(sensors).get();
+        return;
+    }
+
+    const PollPlan& plan = *cachedPlan(sensors);
+    allSensors_.resize(plan.size());
+    std::iota(allSensors_.begin(), allSensors_.end(), 0);
+    readSensors(plan, allSensors_, results);
+}
+
+void MultiPortReader::readSensors(const PollPlan& plan, const std::vector<size_t>& due,
+                                  std::vector<SensorData>& results) {
+    if (loopRunning_ && std::this_thread::get_id() != loopThread_.get_id()) {
+        std::promise<std::vector<SensorData>> promise;
+        std::future<std::vector<SensorData>> future = promise.get_future();
+        readSensorsAsync(plan, due, [&promise](std::vector<SensorData> data) {
+            promise.set_value(std::move(data));
+        });
+        results = future.get();
+        return;
+    }
+
+    beginCycle(plan, due, results, resultIndex_);
+    cycle_ = {&plan, &results, &resultIndex_};
+
+    for (auto& indices : portBlocks_) {
+        indices.clear();
+    }
+    for (size_t b = 0; b < plan.blocks.size(); ++b) {
+        const ReadBlock& block = plan.blocks[b];
+        if (block.port >= readers_.size() || !blockDue(block, resultIndex_)) continue;
+        if (!readers_[block.port]->shouldPoll(block.slave_id)) {
+            markOffline(block, planResult(results, resultIndex_));
+            continue;
+        }
+        portBlocks_[block.port].push_back(b);
+    }
+
+    dispatchBlocks();
+
+    for (const auto& block : plan.blocks) {
+        if (block.port < readers_.size() && blockDue(block, resultIndex_) &&
+            readers_[block.port]->isSlaveOffline(block.slave_id)) {
+            markOffline(block, planResult(results, resultIndex_));
+        }
+    }
+}
+
+void MultiPortReader::dispatchBlocks() {
+#ifdef __linux__
+    if (pollMode_ == PollMode::Reactor && ensureReactor()) {
+        readWithReactor();
+        return;
+    }
+#endif
+
+    size_t activePorts = std::count_if(portBlocks_.begin(), portBlocks_.end(),
+                                       [](const std::vector<size_t>& v) { return !v.empty(); });
+
+    if (pollMode_ == PollMode::Sequential || activePorts <= 1) {
+        for (size_t p = 0; p < portBlocks_.size(); ++p) {
+            readPortBlocks(p);
+        }
+        return;
+    }
+
+    for (size_t p = 0; p < portBlocks_.size(); ++p) {
+        if (portBlocks_[p].empty()) continue;
+        worker(p).post([this, p] { readPortBlocks(p); });
+    }
+
+    for (size_t p = 0; p < portBlocks_.size(); ++p) {
+        if (!portBlocks_[p].empty()) {
+            workers_[p]->wait();
+        }
+    }
+}
+
+MultiPortReader::PortWorker& MultiPortReader::worker(size_t portIndex) {
+    if (!workers_[portIndex]) {
+        workers_[portIndex] = std::make_unique<PortWorker>(realtimeOptions_);
+    }
+    return *workers_[portIndex];
+}
+
+bool MultiPortReader::ensureReactor() {
+#ifdef __linux__
+    if (!reactor_) {
+        reactor_ = std::make_unique<ModbusReactor>();
+        reactorChannels_.assign(readers_.size(), -1);
+        for (size_t p = 0; p < readers_.size(); ++p) {
+            registerChannel(p);
+        }
+    }
+    return reactor_->isValid();
+#else
+    return false;
+#endif
+}
+
+void MultiPortReader::registerChannel(size_t portIndex) {
+#ifdef __linux__
+    if (!reactor_->isValid()) return;
+    if (reactorChannels_[portIndex] >= 0) {
+        reactor_->removeChannel(reactorChannels_[portIndex]);
+    }
+    int handle = readers_[portIndex]->nativeHandle();
+    reactorChannels_[portIndex] = handle >= 0 ? reactor_->addChannel(handle) : -1;
+#else
+    (void)portIndex;
+#endif
+}
+
+struct MultiPortReader::ReactorTarget {
+    MultiPortReader* owner;
+    SensorReader* reader;
+    const ReadBlock* block;
+};
+
+#ifdef __linux__
+void MultiPortReader::submitBlock(size_t portIndex, const ReadBlock& block, BlockDone done) {
+    SensorReader* reader = readers_[portIndex].get();
+    size_t expected = registerResponseLength(block.count);
+    reactor_->submit(reactorChannels_[portIndex], block.request.data(), block.request.size(),
+        reader->frameGap(block.slave_id), reader->responseTimeout(block.slave_id, expected),
+        [&block, reader, done](TransactionStatus status, const uint8_t* frame, size_t length,
+                               std::chrono::microseconds elapsed) {
+            uint16_t values[PollPlanner::kMaxReadRegisters];
+            done(values, finishTransaction(*reader, block, status, frame, length, elapsed, values));
+        });
+}
+#endif
+
+void MultiPortReader::readWithReactor() {
+#ifdef __linux__
+    const CycleContext& cycle = cycle_;
+
+    networkPorts_.clear();
+    for (size_t p = 0; p < portBlocks_.size(); ++p) {
+        if (reactorChannels_[p] < 0 && readers_[p]->isConnected() && !portBlocks_[p].empty()) {
+            worker(p).post([this, p] { readPortBlocks(p); });
+            networkPorts_.push_back(p);
+        }
+    }
+
+    reactorTargets_.resize(cycle.plan->blocks.size());
+    for (size_t p = 0; p < portBlocks_.size(); ++p) {
+        if (reactorChannels_[p] < 0 && readers_[p]->isConnected()) continue;
+        for (size_t blockIndex : portBlocks_[p]) {
+            const ReadBlock& block = cycle.plan->blocks[blockIndex];
+            if (reactorChannels_[p] < 0) {
+                applyPlanResult(*cycle.plan, block, nullptr, ReadError::PortDisconnected, *cycle.results,
+                                *cycle.resultIndex);
+                continue;
             }
+
+            ReactorTarget* target = &reactorTargets_[blockIndex];
+            *target = {this, readers_[p].get(), &block};
+            size_t expected = registerResponseLength(block.count);
+            reactor_->submit(reactorChannels_[p], block.request.data(), block.request.size(),
+                target->reader->frameGap(block.slave_id),
+                target->reader->responseTimeout(block.slave_id, expected),
+                [target](TransactionStatus status, const uint8_t* frame, size_t length,
+                         std::chrono::microseconds elapsed) {
+                    uint16_t values[PollPlanner::kMaxReadRegisters];
+                    const ReadBlock& block = *target->block;
+                    ReadError error = finishTransaction(*target->reader, block, status, frame, length,
+                                                        elapsed, values);
+                    const CycleContext& cycle = target->owner->cycle_;
+                    applyPlanResult(*cycle.plan, block, values, error, *cycle.results, *cycle.resultIndex);
+                });
         }
+    }
+
+    reactor_->run();
+
+    for (size_t p : networkPorts_) {
+        workers_[p]->wait();
+    }
+#endif
+}
+
+struct MultiPortReader::AsyncRead {
+    SensorList sensors;
+    std::shared_ptr<const PollPlan> cached;
+    const PollPlan* plan;
+    std::vector<size_t> due;
+    std::vector<size_t> resultIndex;
+    std::vector<SensorData> results;
+    size_t remaining;
+    SensorsCallback done;
+};
+
+bool MultiPortReader::startEventLoop() {
+#ifdef __linux__
+    if (loopRunning_) return true;
+    if (!ensureReactor()) return false;
 
-        if (!found) {
-            data.error_message = "未找到串口: " + portName;
+    loopRunning_ = true;
+    loopThread_ = std::thread([this] {
+        if (realtimeOptions_.priority > 0 || !realtimeOptions_.cpus.empty()) {
+            cycle::applyRealtime(realtimeOptions_);
         }
+        while (loopRunning_) {
+            reactor_->runOnce(-1);
+        }
+    });
+    return true;
+#else
+    return false;
+#endif
+}
 
-        results.push_back(data);
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+void MultiPortReader::stopEventLoop() {
+#ifdef __linux__
+    if (!loopThread_.joinable()) return;
+    loopRunning_ = false;
+    reactor_->post([] {});
+    loopThread_.join();
+#endif
+}
+
+size_t MultiPortReader::pollEvents(int timeoutMs) {
+#ifdef __linux__
+    if (!loopRunning_ && ensureReactor()) {
+        reactor_->runOnce(timeoutMs);
     }
+#else
+    (void)timeoutMs;
+#endif
+    return asyncPending_;
+}
 
-    return results;
+int MultiPortReader::eventHandle() {
+#ifdef __linux__
+    return ensureReactor() ? reactor_->nativeHandle() : -1;
+#else
+    return -1;
+#endif
+}
+
+void MultiPortReader::readSensorAsync(const SensorEntry& sensor, SensorCallback done) {
+    readAllSensorsAsync(SensorList{sensor}, [done](std::vector<SensorData> results) {
+        done(std::move(results[0]));
+    });
+}
+
+std::future<SensorData> MultiPortReader::readSensorAsync(const SensorEntry& sensor) {
+    startEventLoop();
+    auto promise = std::make_shared<std::promise<SensorData>>();
+    std::future<SensorData> future = promise->get_future();
+    readSensorAsync(sensor, [promise](SensorData data) {
+        promise->set_value(std::move(data));
+    });
+    return future;
+}
+
+std::future<std::vector<SensorData>> MultiPortReader::readAllSensorsAsync(const SensorList& sensors) {
+    startEventLoop();
+    auto promise = std::make_shared<std::promise<std::vector<SensorData>>>();
+    std::future<std::vector<SensorData>> future = promise->get_future();
+    readAllSensorsAsync(sensors, [promise](std::vector<SensorData> results) {
+        promise->set_value(std::move(results));
+    });
+    return future;
+}
+
+void MultiPortReader::readAllSensorsAsync(const SensorList& sensors, SensorsCallback done) {
+#ifdef __linux__
+    if (ensureReactor()) {
+        auto read = std::make_shared<AsyncRead>();
+        read->sensors = sensors;
+        read->remaining = 0;
+        read->done = std::move(done);
+        ++asyncPending_;
+        reactor_->post([this, read] {
+            read->cached = cachedPlan(read->sensors);
+            read->plan = read->cached.get();
+            read->due.resize(read->plan->size());
+            std::iota(read->due.begin(), read->due.end(), 0);
+            startAsyncRead(read);
+        });
+        return;
+    }
+#endif
+    done(readAllSensors(sensors));
+}
+
+void MultiPortReader::readSensorsAsync(const PollPlan& plan, const std::vector<size_t>& due,
+                                       SensorsCallback done) {
+#ifdef __linux__
+    if (ensureReactor()) {
+        auto read = std::make_shared<AsyncRead>();
+        read->plan = &plan;
+        read->due = due;
+        read->remaining = 0;
+        read->done = std::move(done);
+        ++asyncPending_;
+        reactor_->post([this, read] { startAsyncRead(read); });
+        return;
+    }
+#endif
+    std::vector<SensorData> results;
+    readSensors(plan, due, results);
+    done(std::move(results));
+}
+
+void MultiPortReader::startAsyncRead(const std::shared_ptr<AsyncRead>& read) {
+#ifdef __linux__
+    beginCycle(*read->plan, read->due, read->results, read->resultIndex);
+    read->remaining = 1;
+
+    for (size_t b = 0; b < read->plan->blocks.size(); ++b) {
+        const ReadBlock& block = read->plan->blocks[b];
+        size_t p = block.port;
+        if (p >= readers_.size() || !blockDue(block, read->resultIndex)) continue;
+
+        ++read->remaining;
+        if (reactorChannels_[p] < 0) {
+            worker(p).post([this, read, b, p] {
+                const ReadBlock& block = read->plan->blocks[b];
+                SensorReader& reader = *readers_[p];
+                std::vector<uint16_t> values;
+                ReadError error = gateBlock(reader, block);
+                if (error == ReadError::None) {
+                    reader.readRegisterBlocks({&block},
+                        [&](size_t, const uint16_t* blockValues, ReadError blockError) {
+                            error = blockError;
+                            if (error == ReadError::None) {
+                                values.assign(blockValues, blockValues + block.count);
+                            }
+                        });
+                    error = offlineOr(reader, block, error);
+                }
+                reactor_->post([this, read, b, values, error] {
+                    finishAsyncBlock(read, b, values.data(), error);
+                });
+            });
+            continue;
+        }
+
+        ReadError error = gateBlock(*readers_[p], block);
+        if (error != ReadError::None) {
+            finishAsyncBlock(read, b, nullptr, error);
+            continue;
+        }
+        SensorReader* reader = readers_[p].get();
+        submitBlock(p, block, [this, read, b, reader](const uint16_t* values, ReadError error) {
+            finishAsyncBlock(read, b, values, offlineOr(*reader, read->plan->blocks[b], error));
+        });
+    }
+
+    finishAsyncBlock(read, read->plan->blocks.size(), nullptr, ReadError::None);
+#else
+    (void)read;
+#endif
+}
+
+void MultiPortReader::finishAsyncBlock(const std::shared_ptr<AsyncRead>& read, size_t blockIndex,
+                                       const uint16_t* values, ReadError error) {
+    if (blockIndex < read->plan->blocks.size()) {
+        const ReadBlock& block = read->plan->blocks[blockIndex];
+        if (error == ReadError::Offline) {
+            markOffline(block, planResult(read->results, read->resultIndex));
+        } else {
+            applyPlanResult(*read->plan, block, values, error, read->results, read->resultIndex);
+        }
+    }
+    if (--read->remaining > 0) return;
+
+    --asyncPending_;
+    read->done(std::move(read->results));
+}
+
+bool MultiPortReader::setSlaveGap(const std::string& portName, uint8_t slaveId,
+                                  std::chrono::microseconds gap) {
+    auto it = std::find(portNames_.begin(), portNames_.end(), portName);
+    if (it == portNames_.end()) {
+        return false;
+    }
+    readers_[it - portNames_.begin()]->setSlaveGap(slaveId, gap);
+    return true;
+}
+
+bool MultiPortReader::setSerialOptions(const std::string& portName, const SerialOptions& options) {
+    auto it = std::find(portNames_.begin(), portNames_.end(), portName);
+    if (it == portNames_.end()) {
+        return false;
+    }
+    readers_[it - portNames_.begin()]->setSerialOptions(options);
+    return true;
+}
+
+bool MultiPortReader::setTimeoutBounds(const std::string& portName, std::chrono::microseconds minimum,
+                                       std::chrono::microseconds maximum) {
+    auto it = std::find(portNames_.begin(), portNames_.end(), portName);
+    if (it == portNames_.end()) {
+        return false;
+    }
+    readers_[it - portNames_.begin()]->setTimeoutBounds(minimum, maximum);
+    return true;
 }
 
 bool MultiPortReader::isPortConnected(const std::string& portName) const {
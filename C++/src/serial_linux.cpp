@@ -0,0 +1,53 @@
+#include "serial_linux.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+
+#include <asm/termbits.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+
+namespace serial {
+
+bool setCustomBaudrate(int fd, int baudrate) {
+    struct termios2 tty;
+    if (ioctl(fd, TCGETS2, &tty) != 0) {
+        std::cerr << "获取串口属性失败: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    tty.c_cflag &= ~CBAUD;
+    tty.c_cflag |= BOTHER;
+    tty.c_cflag &= ~(CBAUD << IBSHIFT);
+    tty.c_cflag |= BOTHER << IBSHIFT;
+    tty.c_ospeed = static_cast<speed_t>(baudrate);
+    tty.c_ispeed = static_cast<speed_t>(baudrate);
+
+    if (ioctl(fd, TCSETS2, &tty) != 0) {
+        std::cerr << "无法设置波特率 " << baudrate << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool setLowLatency(int fd) {
+    struct serial_struct info;
+    if (ioctl(fd, TIOCGSERIAL, &info) != 0) {
+        return false;
+    }
+
+    info.flags |= ASYNC_LOW_LATENCY;
+    return ioctl(fd, TIOCSSERIAL, &info) == 0;
+}
+
+bool enableRs485(int fd, int delayBeforeSendMs, int delayAfterSendMs) {
+    struct serial_rs485 rs485;
+    std::memset(&rs485, 0, sizeof(rs485));
+    rs485.flags = SER_RS485_ENABLED | SER_RS485_RTS_ON_SEND;
+    rs485.delay_rts_before_send = static_cast<__u32>(delayBeforeSendMs);
+    rs485.delay_rts_after_send = static_cast<__u32>(delayAfterSendMs);
+
+    return ioctl(fd, TIOCSRS485, &rs485) == 0;
+}
+
+} // namespace serial
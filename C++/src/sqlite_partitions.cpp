@@ -0,0 +1,137 @@
+#include "sqlite_partitions.h"
+#include <algorithm>
+#include <cctype>
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+std::tm localTime(std::time_t time) {
+    std::tm tm{};
+#ifdef _WIN32
+    localtime_s(&tm, &time);
+#else
+    localtime_r(&time, &tm);
+#endif
+    return tm;
+}
+
+SQLitePartitions::TimePoint fromLocalTime(std::tm tm) {
+    tm.tm_isdst = -1;
+    return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+}
+
+} // namespace
+
+SQLitePartitions::SQLitePartitions(const std::string& basePath, PartitionPeriod period)
+    : basePath_(basePath), period_(period) {
+    std::filesystem::path path(basePath);
+    directory_ = path.parent_path().string();
+    stem_ = path.stem().string();
+    extension_ = path.extension().string();
+}
+
+SQLitePartitions::Partition SQLitePartitions::at(TimePoint time) const {
+    if (period_ == PartitionPeriod::None) {
+        return {TimePoint::min(), TimePoint::max(), basePath_};
+    }
+    TimePoint start = startOf(time);
+    return {start, endOf(start), pathFor(start)};
+}
+
+std::vector<SQLitePartitions::Partition> SQLitePartitions::list() const {
+    std::vector<Partition> partitions;
+    std::error_code error;
+
+    if (period_ == PartitionPeriod::None) {
+        if (std::filesystem::exists(basePath_, error)) {
+            partitions.push_back(at(TimePoint()));
+        }
+        return partitions;
+    }
+
+    std::filesystem::directory_iterator it(directory_.empty() ? "." : directory_, error);
+    for (; !error && it != std::filesystem::directory_iterator(); it.increment(error)) {
+        Partition partition;
+        if (it->is_regular_file(error) && parse(it->path().filename().string(), partition)) {
+            partitions.push_back(std::move(partition));
+        }
+    }
+    std::sort(partitions.begin(), partitions.end(),
+              [](const Partition& a, const Partition& b) { return a.start < b.start; });
+    return partitions;
+}
+
+std::vector<SQLitePartitions::Partition> SQLitePartitions::covering(TimePoint from, TimePoint to) const {
+    std::vector<Partition> partitions = list();
+    partitions.erase(std::remove_if(partitions.begin(), partitions.end(),
+                                    [&](const Partition& p) { return p.end <= from || p.start > to; }),
+                     partitions.end());
+    return partitions;
+}
+
+size_t SQLitePartitions::dropBefore(TimePoint cutoff, const std::string& keepPath) const {
+    if (period_ == PartitionPeriod::None) return 0;
+
+    size_t dropped = 0;
+    for (const auto& partition : list()) {
+        if (partition.end > cutoff || partition.path == keepPath) continue;
+        std::error_code error;
+        if (std::filesystem::remove(partition.path, error)) {
+            std::filesystem::remove(partition.path + "-wal", error);
+            std::filesystem::remove(partition.path + "-shm", error);
+            ++dropped;
+        }
+    }
+    return dropped;
+}
+
+SQLitePartitions::TimePoint SQLitePartitions::startOf(TimePoint time) const {
+    std::tm tm = localTime(std::chrono::system_clock::to_time_t(time));
+    tm.tm_hour = 0;
+    tm.tm_min = 0;
+    tm.tm_sec = 0;
+    if (period_ == PartitionPeriod::Week) {
+        tm.tm_mday -= (tm.tm_wday + 6) % 7;
+    }
+    return fromLocalTime(tm);
+}
+
+SQLitePartitions::TimePoint SQLitePartitions::endOf(TimePoint start) const {
+    std::tm tm = localTime(std::chrono::system_clock::to_time_t(start));
+    tm.tm_mday += period_ == PartitionPeriod::Week ? 7 : 1;
+    return fromLocalTime(tm);
+}
+
+std::string SQLitePartitions::pathFor(TimePoint start) const {
+    std::tm tm = localTime(std::chrono::system_clock::to_time_t(start));
+    std::ostringstream name;
+    name << stem_ << "_" << std::put_time(&tm, "%Y%m%d") << extension_;
+    return (std::filesystem::path(directory_) / name.str()).string();
+}
+
+bool SQLitePartitions::parse(const std::string& fileName, Partition& partition) const {
+    const size_t dateLength = 8;
+    std::string prefix = stem_ + "_";
+    if (fileName.size() != prefix.size() + dateLength + extension_.size() ||
+        fileName.compare(0, prefix.size(), prefix) != 0 ||
+        fileName.compare(prefix.size() + dateLength, std::string::npos, extension_) != 0) {
+        return false;
+    }
+
+    std::string date = fileName.substr(prefix.size(), dateLength);
+    if (!std::all_of(date.begin(), date.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        return false;
+    }
+
+    std::tm tm{};
+    tm.tm_year = std::stoi(date.substr(0, 4)) - 1900;
+    tm.tm_mon = std::stoi(date.substr(4, 2)) - 1;
+    tm.tm_mday = std::stoi(date.substr(6, 2));
+    partition.start = fromLocalTime(tm);
+    partition.end = endOf(partition.start);
+    partition.path = (std::filesystem::path(directory_) / fileName).string();
+    return true;
+}
@@ -0,0 +1,245 @@
+#include "storage_writer.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+constexpr std::chrono::milliseconds kIdleWait(100);
+constexpr std::chrono::milliseconds kBlockWait(10);
+constexpr size_t kMinSpillCapacity = 4096;
+
+bool fileExists(const std::string& path) {
+    std::ifstream file(path);
+    return file.good();
+}
+
+void writeSpillRecord(std::ostream& out, const SensorRecord& record) {
+    out << record.sensor_id << "," << record.slave_id << ","
+        << std::setprecision(10) << record.temperature << "," << record.humidity << ","
+        << std::chrono::duration_cast<std::chrono::microseconds>(record.timestamp.time_since_epoch()).count()
+        << "," << record.sensor_name << "\n";
+}
+
+bool parseSpillRecord(const std::string& line, SensorRecord& record) {
+    std::istringstream in(line);
+    char comma;
+    long long timestamp;
+    if (!(in >> record.sensor_id >> comma >> record.slave_id >> comma >> record.temperature >> comma
+             >> record.humidity >> comma >> timestamp >> comma)) {
+        return false;
+    }
+    std::getline(in, record.sensor_name);
+    record.timestamp = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::microseconds(timestamp)));
+    return true;
+}
+
+} // namespace
+
+StorageWriter::StorageWriter(std::unique_ptr<DataStorage> storage, const StorageConfig& config)
+    : storage_(std::move(storage)), queue_(std::max<size_t>(config.queue_capacity, 2)),
+      spillQueue_(config.backpressure == Backpressure::Spill ? std::max(config.queue_capacity, kMinSpillCapacity) : 2),
+      policy_(config.backpressure), batchSize_(std::max<size_t>(config.batch_size, 1)),
+      commitInterval_(std::chrono::microseconds(static_cast<long long>(config.commit_interval * 1000000))),
+      spillPath_(config.spill_path), replayPath_(config.spill_path + ".replay"), evicted_(), spillRecord_(),
+      spillPending_(fileExists(config.spill_path) || fileExists(replayPath_)),
+      stopping_(false), maxDepth_(0), written_(0), failed_(0), dropped_(0), spilled_(0),
+      thread_([this] { run(); }) {}
+
+StorageWriter::~StorageWriter() {
+    stop();
+}
+
+void StorageWriter::submit(const std::vector<SensorRecord>& records) {
+    for (const auto& record : records) {
+        if (queue_.tryPush(record)) continue;
+
+        switch (policy_) {
+            case Backpressure::Block:
+                pushBlocking(record);
+                break;
+            case Backpressure::DropOldest:
+                while (!queue_.tryPush(record)) {
+                    if (queue_.tryPop(evicted_)) {
+                        dropped_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                break;
+            case Backpressure::Spill:
+                if (!spillQueue_.tryPush(record)) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                }
+                break;
+        }
+    }
+
+    size_t depth = queue_.size();
+    size_t maxDepth = maxDepth_.load(std::memory_order_relaxed);
+    while (depth > maxDepth && !maxDepth_.compare_exchange_weak(maxDepth, depth, std::memory_order_relaxed)) {
+    }
+    wakeWriter();
+}
+
+void StorageWriter::wakeWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+    }
+    dataReady_.notify_one();
+}
+
+void StorageWriter::pushBlocking(const SensorRecord& record) {
+    while (!queue_.tryPush(record)) {
+        wakeWriter();
+        std::unique_lock<std::mutex> lock(mutex_);
+        spaceReady_.wait_for(lock, kBlockWait);
+    }
+}
+
+void StorageWriter::stop() {
+    if (!thread_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    dataReady_.notify_one();
+    thread_.join();
+    storage_->close();
+}
+
+void StorageWriter::run() {
+    std::vector<SensorRecord> batch;
+    batch.reserve(batchSize_);
+    auto oldest = std::chrono::steady_clock::now();
+
+    while (true) {
+        drainSpill();
+        size_t before = batch.size();
+        while (batch.size() < batchSize_) {
+            batch.emplace_back();
+            if (!queue_.tryPop(batch.back())) {
+                batch.pop_back();
+                break;
+            }
+        }
+        if (batch.size() > before) {
+            spaceReady_.notify_all();
+            if (before == 0) {
+                oldest = std::chrono::steady_clock::now();
+            }
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (!batch.empty() && (batch.size() >= batchSize_ || stopping_ || now - oldest >= commitInterval_)) {
+            write(batch);
+            batch.clear();
+            continue;
+        }
+        if (batch.empty()) {
+            if (replaySpill()) continue;
+            if (stopping_) break;
+        }
+
+        auto deadline = batch.empty() ? now + kIdleWait : oldest + commitInterval_;
+        std::unique_lock<std::mutex> lock(mutex_);
+        dataReady_.wait_until(lock, deadline, [this] {
+            return queue_.size() > 0 || spillQueue_.size() > 0 || stopping_;
+        });
+    }
+}
+
+void StorageWriter::write(const std::vector<SensorRecord>& batch) {
+    if (storage_->saveBatch(batch)) {
+        written_.fetch_add(batch.size(), std::memory_order_relaxed);
+    } else {
+        failed_.fetch_add(batch.size(), std::memory_order_relaxed);
+    }
+}
+
+void StorageWriter::drainSpill() {
+    if (spillQueue_.size() == 0) return;
+
+    std::ofstream spillFile(spillPath_, std::ios::app);
+    if (!spillFile.is_open()) {
+        std::cerr << "无法打开溢写文件: " << spillPath_ << std::endl;
+    }
+    uint64_t count = 0;
+    while (spillQueue_.tryPop(spillRecord_)) {
+        if (spillFile.is_open()) {
+            writeSpillRecord(spillFile, spillRecord_);
+        }
+        ++count;
+    }
+    spillFile.flush();
+    if (spillFile.good()) {
+        spillPending_ = true;
+        spilled_.fetch_add(count, std::memory_order_relaxed);
+    } else {
+        dropped_.fetch_add(count, std::memory_order_relaxed);
+    }
+}
+
+bool StorageWriter::replaySpill() {
+    const std::string& replayPath = replayPath_;
+    if (!spillPending_) return false;
+    if (fileExists(replayPath)) {
+        spillPending_ = fileExists(spillPath_);
+    } else {
+        std::rename(spillPath_.c_str(), replayPath.c_str());
+        spillPending_ = false;
+    }
+
+    std::ifstream file(replayPath);
+    std::vector<SensorRecord> batch;
+    std::string line;
+    SensorRecord record;
+    while (std::getline(file, line)) {
+        if (!parseSpillRecord(line, record)) continue;
+        batch.push_back(record);
+        if (batch.size() == batchSize_) {
+            write(batch);
+            batch.clear();
+        }
+    }
+    if (!batch.empty()) {
+        write(batch);
+    }
+    file.close();
+    std::remove(replayPath.c_str());
+    return true;
+}
+
+size_t StorageWriter::queueDepth() const {
+    return queue_.size();
+}
+
+size_t StorageWriter::maxQueueDepth() const {
+    return maxDepth_.load(std::memory_order_relaxed);
+}
+
+size_t StorageWriter::queueCapacity() const {
+    return queue_.capacity();
+}
+
+uint64_t StorageWriter::written() const {
+    return written_.load(std::memory_order_relaxed);
+}
+
+uint64_t StorageWriter::failed() const {
+    return failed_.load(std::memory_order_relaxed);
+}
+
+uint64_t StorageWriter::dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+uint64_t StorageWriter::spilled() const {
+    return spilled_.load(std::memory_order_relaxed);
+}
+
+uint64_t StorageWriter::duplicates() const {
+    return storage_->duplicates();
+}
@@ -0,0 +1,79 @@
+#include "check.h"
+#include "bounded_queue.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void testSingleThread() {
+    BoundedQueue<int> queue(5);
+    CHECK(queue.capacity() == 8);
+    CHECK(queue.size() == 0);
+
+    int value = 0;
+    CHECK(!queue.tryPop(value));
+    for (int i = 0; i < 8; ++i) {
+        CHECK(queue.tryPush(i));
+    }
+    CHECK(!queue.tryPush(8));
+    CHECK(queue.size() == 8);
+
+    for (int i = 0; i < 8; ++i) {
+        CHECK(queue.tryPop(value) && value == i);
+    }
+    CHECK(!queue.tryPop(value));
+    CHECK(queue.tryPush(42) && queue.tryPop(value) && value == 42);
+}
+
+void testMultipleProducersAndConsumers() {
+    const int kThreads = 4;
+    const uint64_t kPerProducer = 100000;
+    BoundedQueue<uint64_t> queue(64);
+    std::atomic<uint64_t> consumed(0);
+    std::atomic<uint64_t> sum(0);
+    std::vector<std::vector<uint64_t>> lastSeen(kThreads, std::vector<uint64_t>(kThreads, 0));
+    std::atomic<bool> ordered(true);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kThreads; ++p) {
+        threads.emplace_back([&, p] {
+            for (uint64_t i = 1; i <= kPerProducer; ++i) {
+                uint64_t value = (static_cast<uint64_t>(p) << 32) | i;
+                while (!queue.tryPush(value)) std::this_thread::yield();
+            }
+        });
+    }
+    for (int c = 0; c < kThreads; ++c) {
+        threads.emplace_back([&, c] {
+            uint64_t value;
+            while (consumed.load() < kThreads * kPerProducer) {
+                if (!queue.tryPop(value)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                size_t producer = static_cast<size_t>(value >> 32);
+                uint64_t sequence = value & 0xFFFFFFFF;
+                if (sequence <= lastSeen[c][producer]) ordered = false;
+                lastSeen[c][producer] = sequence;
+                sum += sequence;
+                ++consumed;
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    CHECK(consumed.load() == kThreads * kPerProducer);
+    CHECK(sum.load() == kThreads * kPerProducer * (kPerProducer + 1) / 2);
+    CHECK(ordered.load());
+    CHECK(queue.size() == 0);
+}
+
+} // namespace
+
+int main() {
+    testSingleThread();
+    testMultipleProducersAndConsumers();
+    return check::result();
+}
@@ -0,0 +1,34 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <cstdlib>
+#include <iostream>
+
+namespace check {
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+inline void fail(const char* file, int line, const char* expression) {
+    std::cerr << file << ":" << line << ": 检查失败: " << expression << std::endl;
+    ++failures();
+}
+
+inline int result() {
+    if (failures() > 0) {
+        std::cerr << failures() << " 项检查失败" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+} // namespace check
+
+#define CHECK(expression) \
+    do { \
+        if (!(expression)) check::fail(__FILE__, __LINE__, #expression); \
+    } while (0)
+
+#endif
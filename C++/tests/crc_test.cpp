@@ -0,0 +1,54 @@
+#include "check.h"
+#include "modbus_crc.h"
+#include "modbus_rtu.h"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+void testKnownFrame() {
+    const uint8_t frame[] = {0x01, 0x03, 0x00, 0x00, 0x00, 0x0A, 0xC5, 0xCD};
+    CHECK(modbus::crc16(frame, 6) == 0xCDC5);
+    CHECK(modbus::checkCrc(frame, sizeof(frame)));
+
+    uint8_t corrupted[sizeof(frame)];
+    std::copy(frame, frame + sizeof(frame), corrupted);
+    corrupted[3] ^= 0x01;
+    CHECK(!modbus::checkCrc(corrupted, sizeof(corrupted)));
+    CHECK(!modbus::checkCrc(frame, 2));
+}
+
+void testVariantsAgree() {
+    std::mt19937 random(12345);
+    std::vector<uint8_t> data(300);
+    for (auto& byte : data) byte = static_cast<uint8_t>(random());
+
+    for (size_t length = 0; length <= data.size(); ++length) {
+        uint16_t expected = modbus::crc::bitwise(data.data(), length);
+        CHECK(modbus::crc::table(data.data(), length) == expected);
+        CHECK(modbus::crc::slice4(data.data(), length) == expected);
+        CHECK(modbus::crc::slice8(data.data(), length) == expected);
+        CHECK(modbus::crc16(data.data(), length) == expected);
+    }
+}
+
+void testEncodedRequest() {
+    uint8_t request[modbus::kReadRequestLength];
+    modbus::encodeReadRequest(0x11, 0x04, 0x0108, 0x0002, request);
+    CHECK(request[0] == 0x11);
+    CHECK(request[1] == 0x04);
+    CHECK(request[2] == 0x01 && request[3] == 0x08);
+    CHECK(request[4] == 0x00 && request[5] == 0x02);
+    CHECK(modbus::checkCrc(request, sizeof(request)));
+}
+
+} // namespace
+
+int main() {
+    testKnownFrame();
+    testVariantsAgree();
+    testEncodedRequest();
+    return check::result();
+}
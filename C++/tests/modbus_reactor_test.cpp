@@ -0,0 +1,192 @@
+#include "check.h"
+#include "modbus_reactor.h"
+#include "modbus_rtu.h"
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+#include <poll.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+struct Pty {
+    Pty() : master(-1), slave(-1) {
+        if (openpty(&master, &slave, nullptr, nullptr, nullptr) == 0) {
+            termios tio;
+            tcgetattr(slave, &tio);
+            cfmakeraw(&tio);
+            tcsetattr(slave, TCSANOW, &tio);
+        }
+    }
+    ~Pty() {
+        if (master >= 0) close(master);
+        if (slave >= 0) close(slave);
+    }
+    int master;
+    int slave;
+};
+
+struct Result {
+    bool done = false;
+    TransactionStatus status = TransactionStatus::IoError;
+    std::vector<uint8_t> frame;
+};
+
+ModbusReactor::Completion capture(Result& result) {
+    return [&result](TransactionStatus status, const uint8_t* frame, size_t length, microseconds) {
+        result.done = true;
+        result.status = status;
+        result.frame.assign(frame, frame + length);
+    };
+}
+
+void runUntil(ModbusReactor& reactor, const Result& result) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!result.done && std::chrono::steady_clock::now() < deadline) {
+        reactor.runOnce(50);
+    }
+}
+
+std::vector<uint8_t> readResponse(uint8_t slaveId, uint16_t value) {
+    std::vector<uint8_t> frame = {slaveId, 0x03, 0x02, static_cast<uint8_t>(value >> 8),
+                                  static_cast<uint8_t>(value & 0xFF)};
+    uint16_t crc = modbus::crc16(frame.data(), frame.size());
+    frame.push_back(static_cast<uint8_t>(crc & 0xFF));
+    frame.push_back(static_cast<uint8_t>(crc >> 8));
+    return frame;
+}
+
+void answer(int master, const uint8_t* request, const std::vector<uint8_t>& response) {
+    std::vector<uint8_t> received;
+    uint8_t buffer[4096];
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        pollfd pfd{master, POLLIN, 0};
+        if (poll(&pfd, 1, 50) <= 0) continue;
+        ssize_t count = read(master, buffer, sizeof(buffer));
+        if (count <= 0) continue;
+        received.insert(received.end(), buffer, buffer + count);
+        if (received.size() >= modbus::kReadRequestLength &&
+            std::equal(request, request + modbus::kReadRequestLength, received.end() - modbus::kReadRequestLength)) {
+            std::this_thread::sleep_for(milliseconds(5));
+            if (write(master, response.data(), response.size()) < 0) return;
+            return;
+        }
+    }
+}
+
+void testCompleted() {
+    Pty pty;
+    ModbusReactor reactor;
+    int channel = reactor.addChannel(pty.slave);
+    CHECK(channel >= 0);
+
+    uint8_t request[modbus::kReadRequestLength];
+    modbus::encodeReadRequest(1, 0x03, 0, 1, request);
+    std::vector<uint8_t> response = readResponse(1, 0x1234);
+    std::thread slave([&] { answer(pty.master, request, response); });
+
+    Result result;
+    reactor.submit(channel, request, sizeof(request), microseconds(0), milliseconds(500), capture(result));
+    runUntil(reactor, result);
+    slave.join();
+
+    CHECK(result.done);
+    CHECK(result.status == TransactionStatus::Completed);
+    CHECK(result.frame == response);
+    CHECK(reactor.pending() == 0);
+}
+
+void testBlockedWrite() {
+    Pty pty;
+    ModbusReactor reactor;
+    int channel = reactor.addChannel(pty.slave);
+    CHECK(channel >= 0);
+
+    uint8_t filler[512] = {};
+    size_t filled = 0;
+    while (true) {
+        ssize_t written = write(pty.slave, filler, sizeof(filler));
+        if (written <= 0) break;
+        filled += static_cast<size_t>(written);
+    }
+    CHECK(errno == EAGAIN);
+    CHECK(filled > 0);
+
+    uint8_t request[modbus::kReadRequestLength];
+    modbus::encodeReadRequest(2, 0x03, 10, 1, request);
+    std::vector<uint8_t> response = readResponse(2, 0x00FF);
+
+    Result result;
+    reactor.submit(channel, request, sizeof(request), microseconds(0), milliseconds(1000), capture(result));
+    reactor.runOnce(20);
+    CHECK(!result.done);
+
+    std::thread slave([&] { answer(pty.master, request, response); });
+    runUntil(reactor, result);
+    slave.join();
+
+    CHECK(result.done);
+    CHECK(result.status == TransactionStatus::Completed);
+    CHECK(result.frame == response);
+}
+
+void testTimeout() {
+    Pty pty;
+    ModbusReactor reactor;
+    int channel = reactor.addChannel(pty.slave);
+
+    uint8_t request[modbus::kReadRequestLength];
+    modbus::encodeReadRequest(3, 0x03, 0, 1, request);
+    Result result;
+    auto start = std::chrono::steady_clock::now();
+    reactor.submit(channel, request, sizeof(request), microseconds(0), milliseconds(50), capture(result));
+    runUntil(reactor, result);
+
+    CHECK(result.done);
+    CHECK(result.status == TransactionStatus::Timeout);
+    CHECK(std::chrono::steady_clock::now() - start >= milliseconds(50));
+}
+
+void testChannelReuse() {
+    Pty first;
+    Pty second;
+    ModbusReactor reactor;
+    int a = reactor.addChannel(first.slave);
+    int b = reactor.addChannel(second.slave);
+    CHECK(a >= 0 && b >= 0 && a != b);
+
+    for (int i = 0; i < 100; ++i) {
+        reactor.removeChannel(a);
+        int again = reactor.addChannel(first.slave);
+        CHECK(again == a);
+        a = again;
+    }
+
+    reactor.removeChannel(b);
+    Result result;
+    uint8_t request[modbus::kReadRequestLength];
+    modbus::encodeReadRequest(1, 0x03, 0, 1, request);
+    reactor.submit(b, request, sizeof(request), microseconds(0), milliseconds(50), capture(result));
+    CHECK(result.done);
+    CHECK(result.status == TransactionStatus::IoError);
+    CHECK(reactor.addChannel(second.slave) == b);
+}
+
+} // namespace
+
+int main() {
+    testCompleted();
+    testBlockedWrite();
+    testTimeout();
+    testChannelReuse();
+    return check::result();
+}
@@ -0,0 +1,58 @@
+#include "check.h"
+#include "modbus_rtu.h"
+#include <cstdint>
+
+namespace {
+
+void testSlaveAddress() {
+    const uint8_t frame[] = {0x02, 0x03, 0x02, 0x00, 0x01};
+    CHECK(modbus::responseFrameLength(frame, 0, 0x01) == modbus::kMinResponseLength);
+    CHECK(modbus::responseFrameLength(frame, 1, 0x01) == modbus::kRejectFrame);
+    CHECK(modbus::responseFrameLength(frame, 1, 0x02) == modbus::kMinResponseLength);
+}
+
+void testReadResponses() {
+    const uint8_t frame[] = {0x01, 0x03, 0x04, 0x00, 0x01, 0x00, 0x02};
+    CHECK(modbus::responseFrameLength(frame, 2, 0x01) == modbus::kMinResponseLength);
+    CHECK(modbus::responseFrameLength(frame, 3, 0x01) == 9);
+    CHECK(modbus::responseFrameLength(frame, sizeof(frame), 0x01) == 9);
+
+    for (uint8_t funcCode = 0x01; funcCode <= 0x04; ++funcCode) {
+        const uint8_t header[] = {0x01, funcCode, 0x02};
+        CHECK(modbus::responseFrameLength(header, sizeof(header), 0x01) == 7);
+    }
+
+    const uint8_t oversized[] = {0x01, 0x03, 0xFF};
+    CHECK(modbus::responseFrameLength(oversized, sizeof(oversized), 0x01) == modbus::kMaxFrameLength);
+}
+
+void testOtherFrames() {
+    const uint8_t exception[] = {0x01, 0x83, 0x02};
+    CHECK(modbus::responseFrameLength(exception, sizeof(exception), 0x01) == modbus::kMinResponseLength);
+
+    for (uint8_t funcCode : {0x05, 0x06, 0x0F, 0x10}) {
+        const uint8_t frame[] = {0x01, funcCode};
+        CHECK(modbus::responseFrameLength(frame, sizeof(frame), 0x01) == 8);
+    }
+
+    for (uint8_t funcCode : {0x00, 0x07, 0x2B, 0x7F}) {
+        const uint8_t frame[] = {0x01, funcCode};
+        CHECK(modbus::responseFrameLength(frame, sizeof(frame), 0x01) == modbus::kRejectFrame);
+    }
+}
+
+void testTiming() {
+    CHECK(modbus::interFrameGap(9600, 8, 1, 'N') > modbus::interFrameGap(38400, 8, 1, 'N'));
+    CHECK(modbus::interFrameGap(115200, 8, 1, 'N') == modbus::interFrameGap(57600, 8, 1, 'N'));
+    CHECK(modbus::transmissionTime(8, 9600, 8, 1, 'N') < modbus::transmissionTime(8, 9600, 8, 1, 'E'));
+}
+
+} // namespace
+
+int main() {
+    testSlaveAddress();
+    testReadResponses();
+    testOtherFrames();
+    testTiming();
+    return check::result();
+}
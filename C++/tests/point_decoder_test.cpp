@@ -0,0 +1,64 @@
+#include "check.h"
+#include "point_decoder.h"
+#include <cstdint>
+
+namespace {
+
+double decode(DataType type, WordOrder order, uint16_t first, uint16_t second) {
+    const uint16_t registers[] = {first, second};
+    return pointFormat(type, order).decode(registers);
+}
+
+void testSixteenBit() {
+    CHECK(decode(DataType::UInt16, WordOrder::ABCD, 0x1234, 0) == 0x1234);
+    CHECK(decode(DataType::UInt16, WordOrder::CDAB, 0x1234, 0) == 0x1234);
+    CHECK(decode(DataType::UInt16, WordOrder::BADC, 0x3412, 0) == 0x1234);
+    CHECK(decode(DataType::UInt16, WordOrder::DCBA, 0x3412, 0) == 0x1234);
+    CHECK(decode(DataType::UInt16, WordOrder::ABCD, 0xFFFF, 0) == 65535.0);
+    CHECK(decode(DataType::Int16, WordOrder::ABCD, 0xFFFF, 0) == -1.0);
+    CHECK(decode(DataType::Int16, WordOrder::ABCD, 0xFF38, 0) == -200.0);
+    CHECK(decode(DataType::Int16, WordOrder::BADC, 0x38FF, 0) == -200.0);
+}
+
+void testThirtyTwoBit() {
+    CHECK(decode(DataType::UInt32, WordOrder::ABCD, 0x0001, 0x0000) == 65536.0);
+    CHECK(decode(DataType::UInt32, WordOrder::CDAB, 0x0000, 0x0001) == 65536.0);
+    CHECK(decode(DataType::UInt32, WordOrder::BADC, 0x0100, 0x0000) == 65536.0);
+    CHECK(decode(DataType::UInt32, WordOrder::DCBA, 0x0000, 0x0100) == 65536.0);
+    CHECK(decode(DataType::Int32, WordOrder::ABCD, 0xFFFF, 0xFFFE) == -2.0);
+    CHECK(decode(DataType::Int32, WordOrder::CDAB, 0xFFFE, 0xFFFF) == -2.0);
+
+    CHECK(decode(DataType::Float32, WordOrder::ABCD, 0x41C8, 0x0000) == 25.0);
+    CHECK(decode(DataType::Float32, WordOrder::CDAB, 0x0000, 0x41C8) == 25.0);
+    CHECK(decode(DataType::Float32, WordOrder::BADC, 0xC841, 0x0000) == 25.0);
+    CHECK(decode(DataType::Float32, WordOrder::DCBA, 0x0000, 0xC841) == 25.0);
+    CHECK(decode(DataType::Float32, WordOrder::ABCD, 0xC148, 0x0000) == -12.5);
+}
+
+void testFormats() {
+    CHECK(pointFormat(DataType::UInt16, WordOrder::ABCD).width == 1);
+    CHECK(pointFormat(DataType::Int16, WordOrder::DCBA).width == 1);
+    CHECK(pointFormat(DataType::UInt32, WordOrder::ABCD).width == 2);
+    CHECK(pointFormat(DataType::Float32, WordOrder::CDAB).width == 2);
+    CHECK(pointFormat(DataType::Int32, WordOrder::BADC).type == DataType::Int32);
+    CHECK(pointFormat(DataType::Int32, WordOrder::BADC).order == WordOrder::BADC);
+    CHECK(defaultPointFormat().type == DataType::UInt16);
+
+    DataType type;
+    WordOrder order;
+    CHECK(parseDataType("float", type) && type == DataType::Float32);
+    CHECK(parseDataType(dataTypeToString(DataType::Int32), type) && type == DataType::Int32);
+    CHECK(!parseDataType("int64", type));
+    CHECK(parseWordOrder("cdab", order) && order == WordOrder::CDAB);
+    CHECK(parseWordOrder(wordOrderToString(WordOrder::DCBA), order) && order == WordOrder::DCBA);
+    CHECK(!parseWordOrder("ACBD", order));
+}
+
+} // namespace
+
+int main() {
+    testSixteenBit();
+    testThirtyTwoBit();
+    testFormats();
+    return check::result();
+}
@@ -0,0 +1,91 @@
+#include "check.h"
+#include "modbus_crc.h"
+#include "poll_planner.h"
+#include <vector>
+
+namespace {
+
+PlanEntry entry(size_t sensor, size_t port, uint8_t slaveId, uint16_t tempReg, uint16_t humiReg,
+                uint8_t width = 1) {
+    return {sensor, port, slaveId, 0x03, tempReg, humiReg, width, width};
+}
+
+PlannerOptions options(uint16_t maxGap, uint16_t maxRegisters = PollPlanner::kMaxReadRegisters) {
+    PlannerOptions result = PollPlanner::defaultOptions();
+    result.max_gap = maxGap;
+    result.max_registers = maxRegisters;
+    return result;
+}
+
+void testAdjacentMerge() {
+    std::vector<ReadBlock> blocks = PollPlanner::plan({entry(0, 0, 1, 0, 1), entry(1, 0, 1, 2, 3)}, options(0));
+    CHECK(blocks.size() == 1);
+    CHECK(blocks[0].start == 0);
+    CHECK(blocks[0].count == 4);
+    CHECK(blocks[0].slots.size() == 4);
+    CHECK(blocks[0].slots[3].sensor == 1);
+    CHECK(blocks[0].slots[3].field == SensorField::Humidity);
+    CHECK(blocks[0].slots[3].offset == 3);
+}
+
+void testGap() {
+    std::vector<PlanEntry> entries = {entry(0, 0, 1, 0, 1), entry(1, 0, 1, 10, 11)};
+
+    std::vector<ReadBlock> separate = PollPlanner::plan(entries, options(0));
+    CHECK(separate.size() == 2);
+    CHECK(separate[1].start == 10);
+    CHECK(separate[1].count == 2);
+
+    std::vector<ReadBlock> merged = PollPlanner::plan(entries, options(8));
+    CHECK(merged.size() == 1);
+    CHECK(merged[0].start == 0);
+    CHECK(merged[0].count == 12);
+    CHECK(merged[0].slots[2].offset == 10);
+
+    CHECK(PollPlanner::plan(entries, options(7)).size() == 2);
+}
+
+void testGroups() {
+    std::vector<PlanEntry> entries = {entry(0, 0, 1, 0, 1), entry(1, 0, 2, 2, 3), entry(2, 1, 1, 2, 3)};
+    entries.push_back({3, 0, 1, 0x04, 2, 3, 1, 1});
+    std::vector<ReadBlock> blocks = PollPlanner::plan(entries, options(0));
+    CHECK(blocks.size() == 4);
+    for (const auto& block : blocks) {
+        CHECK(block.count == 2);
+        CHECK(block.request[0] == block.slave_id);
+        CHECK(block.request[1] == block.function_code);
+        CHECK(modbus::checkCrc(block.request.data(), block.request.size()));
+    }
+}
+
+void testRegisterLimit() {
+    std::vector<ReadBlock> blocks = PollPlanner::plan({entry(0, 0, 1, 0, 1), entry(1, 0, 1, 2, 3)}, options(0, 3));
+    CHECK(blocks.size() == 2);
+    CHECK(blocks[0].count == 3);
+    CHECK(blocks[1].start == 3);
+
+    std::vector<PlanEntry> wide = {entry(0, 0, 1, 0, 200)};
+    CHECK(PollPlanner::plan(wide, options(300)).size() == 2);
+}
+
+void testWidePoints() {
+    std::vector<ReadBlock> blocks = PollPlanner::plan({entry(0, 0, 1, 0, 2, 2)}, options(0));
+    CHECK(blocks.size() == 1);
+    CHECK(blocks[0].count == 4);
+
+    std::vector<ReadBlock> overlapping = PollPlanner::plan({entry(0, 0, 1, 0, 1, 2)}, options(0));
+    CHECK(overlapping.size() == 1);
+    CHECK(overlapping[0].count == 3);
+    CHECK(overlapping[0].request[5] == 3);
+}
+
+} // namespace
+
+int main() {
+    testAdjacentMerge();
+    testGap();
+    testGroups();
+    testRegisterLimit();
+    testWidePoints();
+    return check::result();
+}
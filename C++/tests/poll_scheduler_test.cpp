@@ -0,0 +1,89 @@
+#include "check.h"
+#include "poll_scheduler.h"
+#include <chrono>
+#include <vector>
+
+namespace {
+
+using Clock = PollScheduler::Clock;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+
+void testOrdering() {
+    Clock::time_point start = Clock::now();
+    PollScheduler scheduler({seconds(1), seconds(3)}, start);
+    CHECK(!scheduler.empty());
+    CHECK(scheduler.nextDeadline() == start);
+
+    std::vector<size_t> due;
+    scheduler.due(start, due);
+    CHECK((due == std::vector<size_t>{0, 1}));
+    CHECK(scheduler.dueDeadline() == start + seconds(1));
+    CHECK(scheduler.nextDeadline() == start + seconds(1));
+
+    scheduler.due(start + milliseconds(999), due);
+    CHECK(due.empty());
+    CHECK(scheduler.dueDeadline() == Clock::time_point::max());
+
+    scheduler.due(start + seconds(1), due);
+    CHECK((due == std::vector<size_t>{0}));
+    CHECK(scheduler.totalMissed() == 0);
+}
+
+void testNoDrift() {
+    Clock::time_point start = Clock::now();
+    PollScheduler scheduler({milliseconds(100)}, start);
+    std::vector<size_t> due;
+    scheduler.due(start, due);
+
+    for (int cycle = 1; cycle <= 50; ++cycle) {
+        Clock::time_point late = start + milliseconds(100) * cycle + milliseconds(30);
+        scheduler.due(late, due);
+        CHECK(due.size() == 1);
+        CHECK(scheduler.dueDeadline() == start + milliseconds(100) * (cycle + 1));
+    }
+    CHECK(scheduler.nextDeadline() == start + milliseconds(5100));
+    CHECK(scheduler.totalMissed() == 0);
+}
+
+void testMissedDeadlines() {
+    Clock::time_point start = Clock::now();
+    PollScheduler scheduler({seconds(1), seconds(3)}, start);
+    std::vector<size_t> due;
+    scheduler.due(start, due);
+
+    scheduler.due(start + milliseconds(5500), due);
+    CHECK(due.size() == 2);
+    CHECK(scheduler.missedDeadlines(0) == 4);
+    CHECK(scheduler.missedDeadlines(1) == 0);
+    CHECK(scheduler.totalMissed() == 4);
+    CHECK(scheduler.dueDeadline() == start + seconds(6));
+
+    scheduler.due(start + milliseconds(9100), due);
+    CHECK(scheduler.missedDeadlines(0) == 7);
+    CHECK(scheduler.missedDeadlines(1) == 1);
+    CHECK(scheduler.totalMissed() == 8);
+    CHECK(scheduler.missedDeadlines(5) == 0);
+}
+
+void testMinimumPeriod() {
+    Clock::time_point start = Clock::now();
+    PollScheduler scheduler({PollScheduler::Duration(0)}, start);
+    std::vector<size_t> due;
+    scheduler.due(start, due);
+    CHECK(scheduler.nextDeadline() == start + milliseconds(1));
+
+    PollScheduler empty({}, start);
+    CHECK(empty.empty());
+    CHECK(empty.nextDeadline() == Clock::time_point::max());
+}
+
+} // namespace
+
+int main() {
+    testOrdering();
+    testNoDrift();
+    testMissedDeadlines();
+    testMinimumPeriod();
+    return check::result();
+}
@@ -0,0 +1,219 @@
+#include "check.h"
+#include "sensor_reader.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#ifndef __cpp_impl_coroutine
+#error "sensor_await_test 需要支持协程的C++20编译器"
+#endif
+
+namespace {
+
+constexpr uint8_t kOfflineSlave = 2;
+
+class TcpSlave {
+public:
+    TcpSlave() : listener_(socket(AF_INET, SOCK_STREAM, 0)), port_(0), stopping_(false) {
+        int reuse = 1;
+        setsockopt(listener_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        if (bind(listener_, reinterpret_cast<sockaddr*>(&address), length) == 0 && listen(listener_, 4) == 0 &&
+            getsockname(listener_, reinterpret_cast<sockaddr*>(&address), &length) == 0) {
+            port_ = ntohs(address.sin_port);
+        }
+        thread_ = std::thread([this] { run(); });
+    }
+
+    ~TcpSlave() {
+        stopping_ = true;
+        thread_.join();
+        close(listener_);
+    }
+
+    int port() const {
+        return port_;
+    }
+
+private:
+    static bool readAll(int fd, uint8_t* data, size_t length) {
+        while (length > 0) {
+            ssize_t received = recv(fd, data, length, 0);
+            if (received <= 0) return false;
+            data += received;
+            length -= static_cast<size_t>(received);
+        }
+        return true;
+    }
+
+    void serve(int fd) {
+        uint8_t request[12];
+        std::vector<uint8_t> response;
+        while (!stopping_) {
+            pollfd pfd{fd, POLLIN, 0};
+            if (poll(&pfd, 1, 50) <= 0) continue;
+            if (!readAll(fd, request, sizeof(request))) return;
+
+            uint8_t slaveId = request[6];
+            uint8_t funcCode = request[7];
+            uint16_t start = static_cast<uint16_t>((request[8] << 8) | request[9]);
+            uint16_t count = static_cast<uint16_t>((request[10] << 8) | request[11]);
+
+            response.assign(request, request + 8);
+            if (slaveId == kOfflineSlave) {
+                response[7] = static_cast<uint8_t>(funcCode | 0x80);
+                response.push_back(0x02);
+            } else {
+                response.push_back(static_cast<uint8_t>(count * 2));
+                for (uint16_t i = 0; i < count; ++i) {
+                    uint16_t value = static_cast<uint16_t>(100 + start + i);
+                    response.push_back(static_cast<uint8_t>(value >> 8));
+                    response.push_back(static_cast<uint8_t>(value & 0xFF));
+                }
+            }
+            size_t length = response.size() - 6;
+            response[4] = static_cast<uint8_t>(length >> 8);
+            response[5] = static_cast<uint8_t>(length & 0xFF);
+            if (send(fd, response.data(), response.size(), MSG_NOSIGNAL) < 0) return;
+        }
+    }
+
+    void run() {
+        while (!stopping_) {
+            pollfd pfd{listener_, POLLIN, 0};
+            if (poll(&pfd, 1, 50) <= 0) continue;
+            int fd = accept(listener_, nullptr, nullptr);
+            if (fd < 0) continue;
+            serve(fd);
+            close(fd);
+        }
+    }
+
+    int listener_;
+    int port_;
+    std::atomic<bool> stopping_;
+    std::thread thread_;
+};
+
+struct Task {
+    struct promise_type {
+        Task get_return_object() {
+            return {};
+        }
+        std::suspend_never initial_suspend() {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() {
+            std::terminate();
+        }
+    };
+};
+
+struct Outcome {
+    std::vector<SensorData> first;
+    std::vector<SensorData> second;
+    std::thread::id resumedOn;
+    std::atomic<bool> done{false};
+};
+
+Task readTwice(MultiPortReader& reader, MultiPortReader::SensorList sensors, Outcome& outcome) {
+    outcome.first = co_await readSensorsAwaitable(reader, sensors);
+    outcome.second = co_await readSensorsAwaitable(reader, sensors);
+    outcome.resumedOn = std::this_thread::get_id();
+    outcome.done = true;
+}
+
+MultiPortReader::SensorList sensorList() {
+    PointFormat format = defaultPointFormat();
+    return {
+        {1, 10, 11, 0.1, 0.5, "tcp-1", "tcp", 0x03, format, format},
+        {kOfflineSlave, 0, 1, 1.0, 1.0, "tcp-2", "tcp", 0x03, format, format},
+        {1, 0, 1, 1.0, 1.0, "missing", "nope", 0x03, format, format},
+    };
+}
+
+void checkResults(const std::vector<SensorData>& results) {
+    CHECK(results.size() == 3);
+    if (results.size() != 3) return;
+
+    CHECK(results[0].sensor_id == 0);
+    CHECK(std::get<5>(sensorList()[results[0].sensor_id]) == "tcp-1");
+    CHECK(!results[0].error);
+    CHECK(results[0].temperature == 11.0);
+    CHECK(results[0].humidity == 55.5);
+
+    CHECK(results[1].sensor_id == 1);
+    CHECK(std::get<5>(sensorList()[results[1].sensor_id]) == "tcp-2");
+    CHECK(results[1].error);
+    CHECK(results[1].error_code == ReadError::IllegalDataAddress);
+
+    CHECK(results[2].sensor_id == 2);
+    CHECK(std::get<5>(sensorList()[results[2].sensor_id]) == "missing");
+    CHECK(results[2].error);
+    CHECK(results[2].error_code == ReadError::PortNotFound);
+}
+
+bool waitFor(const std::atomic<bool>& flag, MultiPortReader* pollReader) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!flag && std::chrono::steady_clock::now() < deadline) {
+        if (pollReader) {
+            pollReader->pollEvents(100);
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+    return flag;
+}
+
+void testPolledByCaller(MultiPortReader& reader) {
+    Outcome outcome;
+    readTwice(reader, sensorList(), outcome);
+    CHECK(waitFor(outcome.done, &reader));
+    checkResults(outcome.first);
+    checkResults(outcome.second);
+    CHECK(outcome.resumedOn == std::this_thread::get_id());
+}
+
+void testEventLoopThread(MultiPortReader& reader) {
+    CHECK(reader.startEventLoop());
+    Outcome outcome;
+    readTwice(reader, sensorList(), outcome);
+    CHECK(waitFor(outcome.done, nullptr));
+    reader.stopEventLoop();
+    checkResults(outcome.first);
+    checkResults(outcome.second);
+    CHECK(outcome.resumedOn != std::this_thread::get_id());
+}
+
+} // namespace
+
+int main() {
+    TcpSlave slave;
+    CHECK(slave.port() > 0);
+
+    MultiPortReader reader;
+    CHECK(reader.addTcpPort("tcp", "127.0.0.1", slave.port(), 500, 4));
+    CHECK(reader.connectAll());
+
+    testPolledByCaller(reader);
+    testEventLoopThread(reader);
+
+    reader.disconnectAll();
+    return check::result();
+}
@@ -0,0 +1,151 @@
+#include "check.h"
+#include "sqlite_partitions.h"
+#include "data_storage.h"
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using TimePoint = SQLitePartitions::TimePoint;
+
+TimePoint localTime(int year, int month, int day, int hour = 0, int minute = 0) {
+    std::tm tm{};
+    tm.tm_year = year - 1900;
+    tm.tm_mon = month - 1;
+    tm.tm_mday = day;
+    tm.tm_hour = hour;
+    tm.tm_min = minute;
+    tm.tm_isdst = -1;
+    return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+}
+
+std::string fileName(const std::string& path) {
+    return std::filesystem::path(path).filename().string();
+}
+
+void touch(const std::filesystem::path& path) {
+    std::ofstream(path.string()).put('\0');
+}
+
+void testDays() {
+    SQLitePartitions partitions("data/sensor.db", PartitionPeriod::Day);
+    SQLitePartitions::Partition partition = partitions.at(localTime(2026, 10, 17, 13, 45));
+    CHECK(partition.start == localTime(2026, 10, 17));
+    CHECK(partition.end == localTime(2026, 10, 18));
+    CHECK(fileName(partition.path) == "sensor_20261017.db");
+    CHECK(std::filesystem::path(partition.path).parent_path() == "data");
+
+    CHECK(partitions.at(localTime(2026, 10, 17)).start == localTime(2026, 10, 17));
+    CHECK(fileName(partitions.at(localTime(2026, 12, 31, 23, 59)).path) == "sensor_20261231.db");
+    CHECK(partitions.at(localTime(2026, 12, 31, 23, 59)).end == localTime(2027, 1, 1));
+    CHECK(partitions.at(localTime(2028, 2, 28, 12)).end == localTime(2028, 2, 29));
+}
+
+void testWeeks() {
+    SQLitePartitions partitions("sensor.db", PartitionPeriod::Week);
+    SQLitePartitions::Partition saturday = partitions.at(localTime(2026, 10, 17, 8));
+    CHECK(saturday.start == localTime(2026, 10, 12));
+    CHECK(saturday.end == localTime(2026, 10, 19));
+    CHECK(saturday.path == "sensor_20261012.db");
+
+    CHECK(partitions.at(localTime(2026, 10, 12)).start == localTime(2026, 10, 12));
+    CHECK(partitions.at(localTime(2026, 10, 18, 23, 59)).start == localTime(2026, 10, 12));
+    CHECK(partitions.at(localTime(2026, 10, 19)).start == localTime(2026, 10, 19));
+    CHECK(partitions.at(localTime(2027, 1, 1)).start == localTime(2026, 12, 28));
+}
+
+void testUnpartitioned() {
+    SQLitePartitions partitions("sensor.db", PartitionPeriod::None);
+    SQLitePartitions::Partition partition = partitions.at(localTime(2026, 10, 17));
+    CHECK(partition.path == "sensor.db");
+    CHECK(partition.start == TimePoint::min());
+    CHECK(partition.end == TimePoint::max());
+    CHECK(partitions.dropBefore(TimePoint::max(), "") == 0);
+}
+
+void testDirectory() {
+    std::filesystem::path directory = std::filesystem::temp_directory_path() /
+        ("sqlite_partitions_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(directory);
+
+    for (const char* name : {"sensor_20261015.db", "sensor_20261016.db", "sensor_20261017.db",
+                             "sensor_20261016.db-wal", "sensor_2026101.db", "sensor_2026x016.db",
+                             "other_20261016.db", "sensor_20261016.sqlite"}) {
+        touch(directory / name);
+    }
+
+    SQLitePartitions partitions((directory / "sensor.db").string(), PartitionPeriod::Day);
+    std::vector<SQLitePartitions::Partition> all = partitions.list();
+    CHECK(all.size() == 3);
+    if (all.size() == 3) {
+        CHECK(fileName(all[0].path) == "sensor_20261015.db");
+        CHECK(all[1].start == localTime(2026, 10, 16));
+        CHECK(all[2].end == localTime(2026, 10, 18));
+    }
+
+    std::vector<SQLitePartitions::Partition> covered =
+        partitions.covering(localTime(2026, 10, 16, 12), localTime(2026, 10, 17));
+    CHECK(covered.size() == 2);
+    if (covered.size() == 2) {
+        CHECK(fileName(covered[0].path) == "sensor_20261016.db");
+        CHECK(fileName(covered[1].path) == "sensor_20261017.db");
+    }
+    CHECK(partitions.covering(localTime(2026, 10, 18), localTime(2026, 10, 20)).empty());
+
+    std::string keep = (directory / "sensor_20261015.db").string();
+    CHECK(partitions.dropBefore(localTime(2026, 10, 17, 12), keep) == 1);
+    CHECK(std::filesystem::exists(keep));
+    CHECK(!std::filesystem::exists(directory / "sensor_20261016.db"));
+    CHECK(!std::filesystem::exists(directory / "sensor_20261016.db-wal"));
+    CHECK(std::filesystem::exists(directory / "sensor_20261017.db"));
+    CHECK(partitions.list().size() == 2);
+
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+}
+
+void testExpiredRecords() {
+    std::filesystem::path directory = std::filesystem::temp_directory_path() /
+        ("sqlite_retention_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(directory);
+
+    StorageConfig config{};
+    config.sqlite_path = (directory / "sensor.db").string();
+    config.sqlite_schema = SQLiteSchema::Compact;
+    config.sqlite_partition = PartitionPeriod::Day;
+    config.sqlite_retention_days = 3;
+    std::unique_ptr<DataStorage> storage = StorageFactory::create(StorageType::SQLite, config);
+    CHECK(storage != nullptr);
+    if (storage) {
+        auto now = std::chrono::system_clock::now();
+        std::vector<SensorRecord> records{{"s1", 0, 1, 21.0, 51.0, now},
+                                          {"s1", 0, 1, 20.0, 50.0, now - std::chrono::hours(24 * 10)}};
+        CHECK(storage->saveBatch(records));
+        storage->close();
+    }
+
+    SQLitePartitions partitions(config.sqlite_path, PartitionPeriod::Day);
+    std::vector<SQLitePartitions::Partition> all = partitions.list();
+    CHECK(all.size() == 1);
+    if (all.size() == 1) {
+        CHECK(all[0].path == partitions.at(std::chrono::system_clock::now()).path);
+    }
+
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+}
+
+} // namespace
+
+int main() {
+    testDays();
+    testWeeks();
+    testUnpartitioned();
+    testDirectory();
+    testExpiredRecords();
+    return check::result();
+}
@@ -0,0 +1,467 @@
+#include "modbus_crc.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+
+#include <pty.h>
+#include <termios.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::atomic<bool> keepRunning(true);
+
+void signalHandler(int) {
+    keepRunning = false;
+}
+
+struct Options {
+    int ports = 1;
+    std::vector<uint8_t> slaves;
+    double latencyMs = 5.0;
+    double jitterMs = 0.0;
+    double exceptionRate = 0.0;
+    double crcErrorRate = 0.0;
+    int baudrate = 0;
+    int tcpPort = 0;
+    std::string linkPrefix;
+    unsigned seed = 1;
+};
+
+struct Stats {
+    unsigned long long requests = 0;
+    unsigned long long responses = 0;
+    unsigned long long exceptions = 0;
+    unsigned long long corrupted = 0;
+    unsigned long long ignored = 0;
+};
+
+struct Endpoint {
+    int fd;
+    bool tcp;
+    std::vector<uint8_t> rx;
+};
+
+struct PendingResponse {
+    Clock::time_point due;
+    int fd;
+    std::vector<uint8_t> bytes;
+};
+
+void printUsage(const char* program) {
+    std::cout << "用法: " << program << " [选项]" << std::endl
+              << "  --ports N            创建N个伪终端 (默认1)" << std::endl
+              << "  --slaves LIST        应答的从站地址，如 1-10,20 (默认1)" << std::endl
+              << "  --latency-ms X       响应延迟毫秒 (默认5)" << std::endl
+              << "  --jitter-ms X        响应延迟随机抖动毫秒 (默认0)" << std::endl
+              << "  --exception-rate P   返回异常响应的概率 (默认0)" << std::endl
+              << "  --crc-error-rate P   返回CRC错误帧的概率 (默认0)" << std::endl
+              << "  --baud N             按波特率模拟响应帧的传输时间 (默认不模拟)" << std::endl
+              << "  --tcp PORT           同时在127.0.0.1:PORT提供Modbus TCP服务" << std::endl
+              << "  --link PREFIX        为伪终端创建符号链接 PREFIX0, PREFIX1, ..." << std::endl
+              << "  --seed N             随机数种子 (默认1)" << std::endl;
+}
+
+bool parseSlaves(const std::string& text, std::vector<uint8_t>& slaves) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t comma = text.find(',', pos);
+        std::string item = text.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+        size_t dash = item.find('-');
+        try {
+            int first = std::stoi(item.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+            if (first < 1 || last > 247 || first > last) return false;
+            for (int id = first; id <= last; ++id) {
+                slaves.push_back(static_cast<uint8_t>(id));
+            }
+        } catch (...) {
+            return false;
+        }
+        if (comma == std::string::npos) break;
+        pos = comma + 1;
+    }
+    return !slaves.empty();
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            std::exit(EXIT_SUCCESS);
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "缺少参数值: " << arg << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+        try {
+            if (arg == "--ports") options.ports = std::stoi(value);
+            else if (arg == "--slaves") {
+                if (!parseSlaves(value, options.slaves)) {
+                    std::cerr << "无效的从站列表: " << value << std::endl;
+                    return false;
+                }
+            }
+            else if (arg == "--latency-ms") options.latencyMs = std::stod(value);
+            else if (arg == "--jitter-ms") options.jitterMs = std::stod(value);
+            else if (arg == "--exception-rate") options.exceptionRate = std::stod(value);
+            else if (arg == "--crc-error-rate") options.crcErrorRate = std::stod(value);
+            else if (arg == "--baud") options.baudrate = std::stoi(value);
+            else if (arg == "--tcp") options.tcpPort = std::stoi(value);
+            else if (arg == "--link") options.linkPrefix = value;
+            else if (arg == "--seed") options.seed = static_cast<unsigned>(std::stoul(value));
+            else {
+                std::cerr << "未知选项: " << arg << std::endl;
+                return false;
+            }
+        } catch (...) {
+            std::cerr << "无效的参数值: " << arg << " " << value << std::endl;
+            return false;
+        }
+    }
+
+    if (options.slaves.empty()) {
+        options.slaves.push_back(1);
+    }
+    return options.ports >= 0 && (options.ports > 0 || options.tcpPort > 0);
+}
+
+uint16_t registerValue(uint8_t slaveId, uint16_t address) {
+    return static_cast<uint16_t>(200 + slaveId * 10 + address);
+}
+
+class Simulator {
+public:
+    explicit Simulator(const Options& options)
+        : options_(options), rng_(options.seed), unit_(0.0, 1.0) {
+        std::fill(std::begin(served_), std::end(served_), false);
+        for (uint8_t id : options_.slaves) {
+            served_[id] = true;
+        }
+    }
+
+    ~Simulator() {
+        for (int fd : slaveFds_) close(fd);
+        for (const auto& endpoint : endpoints_) close(endpoint.fd);
+        if (listenFd_ >= 0) close(listenFd_);
+        for (const auto& link : links_) unlink(link.c_str());
+    }
+
+    bool open() {
+        for (int i = 0; i < options_.ports; ++i) {
+            int master = -1;
+            int slave = -1;
+            char name[256];
+            if (openpty(&master, &slave, name, nullptr, nullptr) != 0) {
+                std::cerr << "openpty失败: " << std::strerror(errno) << std::endl;
+                return false;
+            }
+
+            struct termios tty;
+            tcgetattr(slave, &tty);
+            cfmakeraw(&tty);
+            tcsetattr(slave, TCSANOW, &tty);
+            tcgetattr(master, &tty);
+            cfmakeraw(&tty);
+            tcsetattr(master, TCSANOW, &tty);
+
+            fcntl(master, F_SETFL, fcntl(master, F_GETFL, 0) | O_NONBLOCK);
+            endpoints_.push_back({master, false, {}});
+            slaveFds_.push_back(slave);
+
+            std::string path = name;
+            if (!options_.linkPrefix.empty()) {
+                std::string link = options_.linkPrefix + std::to_string(i);
+                unlink(link.c_str());
+                if (symlink(name, link.c_str()) == 0) {
+                    links_.push_back(link);
+                    path = link + " -> " + name;
+                } else {
+                    std::cerr << "无法创建符号链接: " << link << std::endl;
+                }
+            }
+            std::cout << "串口" << i << ": " << path << std::endl;
+        }
+
+        if (options_.tcpPort > 0 && !openTcp()) {
+            return false;
+        }
+        return true;
+    }
+
+    void run() {
+        std::vector<pollfd> fds;
+
+        while (keepRunning) {
+            fds.clear();
+            for (const auto& endpoint : endpoints_) {
+                fds.push_back({endpoint.fd, POLLIN, 0});
+            }
+            if (listenFd_ >= 0) {
+                fds.push_back({listenFd_, POLLIN, 0});
+            }
+
+            int timeoutMs = 200;
+            if (!pending_.empty()) {
+                auto wait = std::chrono::ceil<std::chrono::milliseconds>(pending_.front().due - Clock::now());
+                timeoutMs = static_cast<int>(std::max<long long>(0, std::min<long long>(timeoutMs, wait.count())));
+            }
+
+            int ready = poll(fds.data(), fds.size(), timeoutMs);
+            if (ready < 0 && errno != EINTR) {
+                std::cerr << "poll失败: " << std::strerror(errno) << std::endl;
+                break;
+            }
+
+            if (ready > 0) {
+                size_t endpointCount = endpoints_.size();
+                for (size_t i = 0; i < endpointCount; ++i) {
+                    if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                        receive(i);
+                    }
+                }
+                if (listenFd_ >= 0 && (fds.back().revents & POLLIN)) {
+                    acceptClient();
+                }
+                endpoints_.erase(std::remove_if(endpoints_.begin(), endpoints_.end(),
+                                                [](const Endpoint& e) { return e.fd < 0; }),
+                                 endpoints_.end());
+            }
+
+            flushDue();
+        }
+    }
+
+    void printStats() const {
+        std::cout << "请求: " << stats_.requests
+                  << ", 响应: " << stats_.responses
+                  << ", 异常响应: " << stats_.exceptions
+                  << ", CRC错误: " << stats_.corrupted
+                  << ", 未应答: " << stats_.ignored << std::endl;
+    }
+
+private:
+    bool openTcp() {
+        listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+        if (listenFd_ < 0) return false;
+
+        int reuse = 1;
+        setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        sockaddr_in addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<uint16_t>(options_.tcpPort));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            listen(listenFd_, 16) != 0) {
+            std::cerr << "无法监听TCP端口 " << options_.tcpPort << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        std::cout << "Modbus TCP: 127.0.0.1:" << options_.tcpPort << std::endl;
+        return true;
+    }
+
+    void acceptClient() {
+        int fd = accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) return;
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        endpoints_.push_back({fd, true, {}});
+    }
+
+    void receive(size_t index) {
+        Endpoint& endpoint = endpoints_[index];
+        uint8_t chunk[512];
+        ssize_t n = read(endpoint.fd, chunk, sizeof(chunk));
+        if (n <= 0) {
+            if (endpoint.tcp && (n == 0 || (errno != EAGAIN && errno != EINTR))) {
+                close(endpoint.fd);
+                endpoint.fd = -1;
+            }
+            return;
+        }
+        endpoint.rx.insert(endpoint.rx.end(), chunk, chunk + n);
+
+        if (endpoint.tcp) {
+            processTcp(endpoint);
+        } else {
+            processRtu(endpoint);
+        }
+    }
+
+    void processRtu(Endpoint& endpoint) {
+        auto& rx = endpoint.rx;
+        while (rx.size() >= 8) {
+            if (!modbus::checkCrc(rx.data(), 8)) {
+                rx.erase(rx.begin());
+                continue;
+            }
+
+            uint8_t slaveId = rx[0];
+            std::vector<uint8_t> pdu;
+            bool answer = handleRequest(slaveId, rx.data() + 1, pdu);
+            rx.erase(rx.begin(), rx.begin() + 8);
+            if (!answer) continue;
+
+            std::vector<uint8_t> frame;
+            frame.push_back(slaveId);
+            frame.insert(frame.end(), pdu.begin(), pdu.end());
+            uint16_t crc = modbus::crc16(frame.data(), frame.size());
+            frame.push_back(crc & 0xFF);
+            frame.push_back((crc >> 8) & 0xFF);
+
+            if (unit_(rng_) < options_.crcErrorRate) {
+                frame[frame.size() - 1] ^= 0x5A;
+                stats_.corrupted++;
+            }
+            schedule(endpoint.fd, std::move(frame));
+        }
+    }
+
+    void processTcp(Endpoint& endpoint) {
+        auto& rx = endpoint.rx;
+        while (rx.size() >= 8) {
+            size_t length = (static_cast<size_t>(rx[4]) << 8) | rx[5];
+            if (length < 2 || length > 254) {
+                rx.clear();
+                return;
+            }
+            if (rx.size() < 6 + length) return;
+
+            uint8_t unitId = rx[6];
+            std::vector<uint8_t> pdu;
+            bool answer = length >= 6 && handleRequest(unitId, rx.data() + 7, pdu);
+
+            std::vector<uint8_t> adu(rx.begin(), rx.begin() + 4);
+            rx.erase(rx.begin(), rx.begin() + 6 + length);
+            if (!answer) continue;
+
+            adu.push_back(((pdu.size() + 1) >> 8) & 0xFF);
+            adu.push_back((pdu.size() + 1) & 0xFF);
+            adu.push_back(unitId);
+            adu.insert(adu.end(), pdu.begin(), pdu.end());
+            schedule(endpoint.fd, std::move(adu));
+        }
+    }
+
+    bool handleRequest(uint8_t slaveId, const uint8_t* request, std::vector<uint8_t>& pdu) {
+        stats_.requests++;
+        if (!served_[slaveId]) {
+            stats_.ignored++;
+            return false;
+        }
+
+        uint8_t funcCode = request[0];
+        uint16_t start = static_cast<uint16_t>((request[1] << 8) | request[2]);
+        uint16_t count = static_cast<uint16_t>((request[3] << 8) | request[4]);
+
+        if (funcCode != 0x03 && funcCode != 0x04) {
+            pdu = {static_cast<uint8_t>(funcCode | 0x80), 0x01};
+            stats_.exceptions++;
+            return true;
+        }
+        if (count == 0 || count > 125) {
+            pdu = {static_cast<uint8_t>(funcCode | 0x80), 0x03};
+            stats_.exceptions++;
+            return true;
+        }
+        if (unit_(rng_) < options_.exceptionRate) {
+            pdu = {static_cast<uint8_t>(funcCode | 0x80), 0x04};
+            stats_.exceptions++;
+            return true;
+        }
+
+        pdu.push_back(funcCode);
+        pdu.push_back(static_cast<uint8_t>(count * 2));
+        for (uint16_t i = 0; i < count; ++i) {
+            uint16_t value = registerValue(slaveId, static_cast<uint16_t>(start + i));
+            pdu.push_back((value >> 8) & 0xFF);
+            pdu.push_back(value & 0xFF);
+        }
+        return true;
+    }
+
+    void schedule(int fd, std::vector<uint8_t> bytes) {
+        double delayMs = options_.latencyMs;
+        if (options_.jitterMs > 0.0) {
+            delayMs += (unit_(rng_) * 2.0 - 1.0) * options_.jitterMs;
+        }
+        if (options_.baudrate > 0) {
+            delayMs += bytes.size() * 11.0 * 1000.0 / options_.baudrate;
+        }
+
+        auto due = Clock::now() + std::chrono::microseconds(static_cast<long long>(std::max(0.0, delayMs) * 1000));
+        PendingResponse response{due, fd, std::move(bytes)};
+        auto it = std::upper_bound(pending_.begin(), pending_.end(), response,
+                                   [](const PendingResponse& a, const PendingResponse& b) { return a.due < b.due; });
+        pending_.insert(it, std::move(response));
+    }
+
+    void flushDue() {
+        auto now = Clock::now();
+        while (!pending_.empty() && pending_.front().due <= now) {
+            const PendingResponse& response = pending_.front();
+            bool open = std::any_of(endpoints_.begin(), endpoints_.end(),
+                                    [&](const Endpoint& e) { return e.fd == response.fd; });
+            if (open && write(response.fd, response.bytes.data(), response.bytes.size()) > 0) {
+                stats_.responses++;
+            }
+            pending_.erase(pending_.begin());
+        }
+    }
+
+    Options options_;
+    std::mt19937 rng_;
+    std::uniform_real_distribution<double> unit_;
+    bool served_[256];
+    std::vector<Endpoint> endpoints_;
+    std::vector<int> slaveFds_;
+    std::vector<std::string> links_;
+    std::vector<PendingResponse> pending_;
+    int listenFd_ = -1;
+    Stats stats_;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    signal(SIGINT, signalHandler);
+    signal(SIGTERM, signalHandler);
+
+    Simulator simulator(options);
+    if (!simulator.open()) {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Modbus从站模拟器已启动，按 Ctrl+C 退出" << std::endl;
+    simulator.run();
+    simulator.printStats();
+    return EXIT_SUCCESS;
+}
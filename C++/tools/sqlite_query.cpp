@@ -0,0 +1,222 @@
+#include "config.h"
+#include "sqlite_partitions.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sqlite3.h>
+
+namespace {
+
+using TimePoint = std::chrono::system_clock::time_point;
+
+struct Options {
+    std::string configPath = "config.json";
+    std::string from;
+    std::string to;
+    std::string sql;
+};
+
+void printUsage(const char* program) {
+    std::cout << "用法: " << program << " [选项] [SQL]" << std::endl
+              << "在SQLite存储上执行查询，按天/周分区时只附加时间范围内的分区，结果以CSV输出" << std::endl
+              << "  --config FILE        配置文件 (默认config.json)" << std::endl
+              << "  --from TIME          起始时间 YYYY-MM-DD 或 \"YYYY-MM-DD HH:MM:SS\" (默认24小时前)" << std::endl
+              << "  --to TIME            结束时间 (默认现在)" << std::endl
+              << "SQL中可以用 :from 和 :to 引用时间范围(Unix秒)，不指定SQL时输出时间范围内的全部记录" << std::endl;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            std::exit(EXIT_SUCCESS);
+        }
+        if (arg == "--config" || arg == "--from" || arg == "--to") {
+            if (i + 1 >= argc) return false;
+            std::string value = argv[++i];
+            if (arg == "--config") options.configPath = value;
+            else if (arg == "--from") options.from = value;
+            else options.to = value;
+            continue;
+        }
+        if (!options.sql.empty()) return false;
+        options.sql = arg;
+    }
+    return true;
+}
+
+bool parseTime(const std::string& text, TimePoint& time) {
+    std::tm tm{};
+    std::istringstream in(text);
+    in >> std::get_time(&tm, text.size() > 10 ? "%Y-%m-%d %H:%M:%S" : "%Y-%m-%d");
+    if (in.fail()) return false;
+    tm.tm_isdst = -1;
+    time = std::chrono::system_clock::from_time_t(std::mktime(&tm));
+    return true;
+}
+
+void printCsvField(const char* text) {
+    if (!text) return;
+    std::string value(text);
+    if (value.find_first_of(",\"\n") == std::string::npos) {
+        std::cout << value;
+        return;
+    }
+    std::cout << '"';
+    for (char c : value) {
+        if (c == '"') std::cout << '"';
+        std::cout << c;
+    }
+    std::cout << '"';
+}
+
+struct Query {
+    std::string sql;
+    std::vector<std::string> tables;
+    TimePoint from;
+    TimePoint to;
+};
+
+bool attachPartitions(sqlite3* db, const std::vector<SQLitePartitions::Partition>& partitions, size_t begin,
+                      size_t end, const std::vector<std::string>& tables) {
+    std::vector<std::string> viewSql;
+    for (const auto& table : tables) {
+        viewSql.push_back("CREATE TEMP VIEW " + table + " AS ");
+    }
+
+    for (size_t i = begin; i < end; ++i) {
+        std::string schema = "p" + std::to_string(i - begin);
+        std::string attachSql = "ATTACH DATABASE ? AS " + schema;
+        sqlite3_stmt* attach = nullptr;
+        sqlite3_prepare_v2(db, attachSql.c_str(), -1, &attach, nullptr);
+        sqlite3_bind_text(attach, 1, partitions[i].path.c_str(), -1, SQLITE_TRANSIENT);
+        int result = sqlite3_step(attach);
+        sqlite3_finalize(attach);
+        if (result != SQLITE_DONE) {
+            std::cerr << "无法附加 " << partitions[i].path << ": " << sqlite3_errmsg(db) << std::endl;
+            return false;
+        }
+        for (size_t t = 0; t < tables.size(); ++t) {
+            viewSql[t] += (i > begin ? " UNION ALL " : "") + std::string("SELECT * FROM ") + schema + "." + tables[t];
+        }
+    }
+
+    for (const auto& sqlText : viewSql) {
+        char* errMsg = nullptr;
+        if (sqlite3_exec(db, sqlText.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+            std::cerr << "创建查询视图失败: " << errMsg << std::endl;
+            sqlite3_free(errMsg);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool runQuery(sqlite3* db, const Query& query, bool printHeader) {
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, query.sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "SQL错误: " << sqlite3_errmsg(db) << std::endl;
+        return false;
+    }
+
+    int fromIndex = sqlite3_bind_parameter_index(stmt, ":from");
+    int toIndex = sqlite3_bind_parameter_index(stmt, ":to");
+    if (fromIndex > 0) {
+        sqlite3_bind_int64(stmt, fromIndex, static_cast<sqlite3_int64>(std::chrono::system_clock::to_time_t(query.from)));
+    }
+    if (toIndex > 0) {
+        sqlite3_bind_int64(stmt, toIndex, static_cast<sqlite3_int64>(std::chrono::system_clock::to_time_t(query.to)));
+    }
+
+    int columns = sqlite3_column_count(stmt);
+    if (printHeader) {
+        for (int c = 0; c < columns; ++c) {
+            std::cout << (c ? "," : "");
+            printCsvField(sqlite3_column_name(stmt, c));
+        }
+        if (columns > 0) std::cout << "\n";
+    }
+
+    int result;
+    while ((result = sqlite3_step(stmt)) == SQLITE_ROW) {
+        for (int c = 0; c < columns; ++c) {
+            std::cout << (c ? "," : "");
+            printCsvField(reinterpret_cast<const char*>(sqlite3_column_text(stmt, c)));
+        }
+        std::cout << "\n";
+    }
+
+    bool ok = result == SQLITE_DONE;
+    if (!ok) {
+        std::cerr << "查询失败: " << sqlite3_errmsg(db) << std::endl;
+    }
+    sqlite3_finalize(stmt);
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Query query;
+    query.to = std::chrono::system_clock::now();
+    query.from = query.to - std::chrono::hours(24);
+    if ((!options.from.empty() && !parseTime(options.from, query.from)) ||
+        (!options.to.empty() && !parseTime(options.to, query.to))) {
+        std::cerr << "时间格式错误，应为 YYYY-MM-DD 或 \"YYYY-MM-DD HH:MM:SS\"" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    AppConfig config = Config::exists(options.configPath) ? Config::load(options.configPath) : Config::loadDefault();
+    const char* view = config.storage.sqlite_schema == SQLiteSchema::Compact ? "sensor_readings" : "sensor_data";
+    SQLitePartitions partitions(config.storage.sqlite_path, config.storage.sqlite_partition);
+    std::vector<SQLitePartitions::Partition> covered = partitions.covering(query.from, query.to);
+    if (covered.empty()) {
+        std::cerr << "时间范围内没有数据库文件: " << config.storage.sqlite_path << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    bool compact = config.storage.sqlite_schema == SQLiteSchema::Compact;
+    query.tables = {view};
+    if (config.storage.sqlite_rollups) {
+        query.tables.push_back(compact ? "sensor_rollup_1m" : "rollup_1m");
+        query.tables.push_back(compact ? "sensor_rollup_1h" : "rollup_1h");
+    }
+    query.sql = options.sql.empty()
+        ? std::string("SELECT * FROM ") + view + " WHERE timestamp BETWEEN :from AND :to ORDER BY timestamp"
+        : options.sql;
+
+    size_t attachLimit = 0;
+    for (size_t begin = 0; begin < covered.size();) {
+        sqlite3* db = nullptr;
+        sqlite3_open(":memory:", &db);
+        sqlite3_busy_timeout(db, 5000);
+        if (attachLimit == 0) {
+            attachLimit = static_cast<size_t>(std::max(1, sqlite3_limit(db, SQLITE_LIMIT_ATTACHED, -1)));
+            if (covered.size() > attachLimit) {
+                std::cerr << "时间范围覆盖 " << covered.size() << " 个分区，超过SQLite一次最多附加的 " << attachLimit
+                          << " 个数据库，将按时间顺序分组依次查询，排序和聚合只在每组内生效" << std::endl;
+            }
+        }
+
+        size_t end = std::min(covered.size(), begin + attachLimit);
+        bool ok = attachPartitions(db, covered, begin, end, query.tables) && runQuery(db, query, begin == 0);
+        sqlite3_close(db);
+        if (!ok) return EXIT_FAILURE;
+        begin = end;
+    }
+    return EXIT_SUCCESS;
+}
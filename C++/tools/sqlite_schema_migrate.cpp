@@ -0,0 +1,155 @@
+#include "config.h"
+#include "data_storage.h"
+#include <chrono>
+#include <ctime>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <sqlite3.h>
+
+namespace {
+
+struct Options {
+    std::string configPath;
+    std::string sourcePath;
+    std::string targetPath;
+    size_t batchSize = 10000;
+};
+
+void printUsage(const char* program) {
+    std::cout << "用法: " << program << " [选项] <旧数据库> <新数据库>" << std::endl
+              << "把 sensor_data 表结构的SQLite数据库转换为紧凑表结构 (sensors + readings)" << std::endl
+              << "  --config FILE        读取传感器的数据类型和缩放系数，以及SQLite参数" << std::endl
+              << "  --batch N            每个事务写入的记录数 (默认10000)" << std::endl;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            std::exit(EXIT_SUCCESS);
+        }
+        if (arg == "--config" || arg == "--batch") {
+            if (i + 1 >= argc) return false;
+            std::string value = argv[++i];
+            if (arg == "--config") {
+                options.configPath = value;
+            } else {
+                try {
+                    options.batchSize = static_cast<size_t>(std::stoul(value));
+                } catch (...) {
+                    return false;
+                }
+                if (options.batchSize == 0) return false;
+            }
+            continue;
+        }
+        paths.push_back(arg);
+    }
+    if (paths.size() != 2 || paths[0] == paths[1]) return false;
+    options.sourcePath = paths[0];
+    options.targetPath = paths[1];
+    return true;
+}
+
+long long fileSize(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return file.is_open() ? static_cast<long long>(file.tellg()) : 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (std::ifstream(options.targetPath).good()) {
+        std::cerr << "目标数据库已存在: " << options.targetPath << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    AppConfig config = options.configPath.empty() ? Config::loadDefault() : Config::load(options.configPath);
+    config.storage.sqlite_path = options.targetPath;
+    config.storage.sqlite_schema = SQLiteSchema::Compact;
+    config.storage.sqlite_partition = PartitionPeriod::None;
+
+    sqlite3* source = nullptr;
+    if (sqlite3_open_v2(options.sourcePath.c_str(), &source, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+        std::cerr << "无法打开SQLite数据库: " << sqlite3_errmsg(source) << std::endl;
+        sqlite3_close(source);
+        return EXIT_FAILURE;
+    }
+
+    sqlite3_stmt* select = nullptr;
+    if (sqlite3_prepare_v2(source,
+                           "SELECT sensor_name, slave_id, temperature, humidity, timestamp FROM sensor_data ORDER BY id",
+                           -1, &select, nullptr) != SQLITE_OK) {
+        std::cerr << "读取 sensor_data 表失败: " << sqlite3_errmsg(source) << std::endl;
+        sqlite3_close(source);
+        return EXIT_FAILURE;
+    }
+
+    auto target = StorageFactory::create(StorageType::SQLite, config.storage, config.modbus.sensors);
+    if (!target) {
+        sqlite3_finalize(select);
+        sqlite3_close(source);
+        return EXIT_FAILURE;
+    }
+
+    std::map<std::string, uint32_t> sensorIds;
+    std::vector<SensorRecord> batch;
+    batch.reserve(options.batchSize);
+    long long migrated = 0;
+    bool ok = true;
+
+    int result = SQLITE_DONE;
+    while (ok && (result = sqlite3_step(select)) == SQLITE_ROW) {
+        SensorRecord record;
+        const unsigned char* name = sqlite3_column_text(select, 0);
+        record.sensor_name = name ? reinterpret_cast<const char*>(name) : "";
+        record.sensor_id = sensorIds.emplace(record.sensor_name, static_cast<uint32_t>(sensorIds.size())).first->second;
+        record.slave_id = sqlite3_column_int(select, 1);
+        record.temperature = sqlite3_column_double(select, 2);
+        record.humidity = sqlite3_column_double(select, 3);
+        record.timestamp = std::chrono::system_clock::from_time_t(static_cast<std::time_t>(sqlite3_column_int64(select, 4)));
+        batch.push_back(std::move(record));
+
+        if (batch.size() == options.batchSize) {
+            ok = target->saveBatch(batch);
+            migrated += static_cast<long long>(batch.size());
+            batch.clear();
+            std::cout << "\r已转换 " << migrated << " 条记录" << std::flush;
+        }
+    }
+    if (ok && !batch.empty()) {
+        ok = target->saveBatch(batch);
+        migrated += static_cast<long long>(batch.size());
+    }
+    if (ok && result != SQLITE_DONE) {
+        std::cerr << std::endl << "读取旧数据库失败: " << sqlite3_errmsg(source) << std::endl;
+        ok = false;
+    }
+
+    sqlite3_finalize(select);
+    sqlite3_close(source);
+    target->close();
+
+    if (!ok) {
+        std::cerr << std::endl << "转换失败, 已写入的部分保留在 " << options.targetPath << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "\r已转换 " << migrated << " 条记录, " << sensorIds.size() << " 个传感器" << std::endl;
+    std::cout << "数据库大小: " << fileSize(options.sourcePath) / 1024 << "KB -> "
+              << fileSize(options.targetPath) / 1024 << "KB" << std::endl;
+    return EXIT_SUCCESS;
+}